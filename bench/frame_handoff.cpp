@@ -0,0 +1,259 @@
+/**
+ * 帧交接微基准
+ *
+ * 在 1280x720 BGR 下对比采集线程把帧交给主线程的几种方式：
+ * - clone+mutex：最初的实现，采集线程在锁内 clone 到共享帧，主线程在锁内再 clone 出来
+ * - TripleBuffer：采集线程读入后台缓冲后交换原子索引，主线程取前台缓冲的 Mat 头
+ * - FramePool：当前实现，读入预分配的池槽位后发布，主线程按引用计数借用
+ *
+ * 两个线程都不限速，即最坏的争用情况。"读取"（帧源把像素写入目标缓冲的那一次拷贝）
+ * 各方式都有，不计入结果；copy 为交接本身的像素拷贝耗时，lock wait 为等锁耗时
+ * （无锁方式给出交接调用本身的耗时）。
+ *
+ * 用法：frame_handoff [帧数]
+ */
+
+#include "camera/FramePool.h"
+#include "core/TripleBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+using namespace popcorn;
+
+constexpr int FRAME_WIDTH = 1280;
+constexpr int FRAME_HEIGHT = 720;
+constexpr int DEFAULT_FRAMES = 2000;
+constexpr size_t POOL_SLOTS = 4;
+
+int64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * 一类耗时的累计
+ */
+struct Timing {
+    double totalUs{0.0};
+    double maxUs{0.0};
+    uint64_t count{0};
+
+    void add(double us) {
+        totalUs += us;
+        maxUs = std::max(maxUs, us);
+        ++count;
+    }
+    double averageUs() const { return count > 0 ? totalUs / count : 0.0; }
+};
+
+/**
+ * 一种交接方式的结果（生产者 / 消费者各自的耗时）
+ */
+struct Result {
+    Timing producerCopy;
+    Timing producerWait;
+    Timing consumerCopy;
+    Timing consumerWait;
+    uint64_t framesProduced{0};
+    uint64_t framesConsumed{0};
+    double elapsedMs{0.0};
+    uint64_t checksum{0};       // 防止消费端的读取被优化掉
+};
+
+/**
+ * 模拟采集：帧源把像素写入目标缓冲（各方式相同，不计入结果）
+ */
+void readFrame(const cv::Mat& source, cv::Mat& target, uint64_t sequence) {
+    source.copyTo(target);
+    target.data[0] = static_cast<uint8_t>(sequence);
+}
+
+// 最初的实现：锁内 clone 进、锁内 clone 出
+Result runCloneMutex(const cv::Mat& source, int frames) {
+    Result result;
+    std::mutex mutex;
+    cv::Mat shared;
+    uint64_t sharedSequence = 0;
+    std::atomic<bool> done{false};
+
+    int64_t start = nowMicros();
+    std::thread producer([&] {
+        cv::Mat captured;
+        for (int i = 1; i <= frames; ++i) {
+            readFrame(source, captured, i);
+
+            int64_t t0 = nowMicros();
+            std::unique_lock<std::mutex> lock(mutex);
+            int64_t t1 = nowMicros();
+            shared = captured.clone();
+            sharedSequence = i;
+            lock.unlock();
+            int64_t t2 = nowMicros();
+
+            result.producerWait.add(static_cast<double>(t1 - t0));
+            result.producerCopy.add(static_cast<double>(t2 - t1));
+            ++result.framesProduced;
+        }
+        done = true;
+    });
+
+    uint64_t lastSequence = 0;
+    cv::Mat frame;
+    while (!done) {
+        int64_t t0 = nowMicros();
+        std::unique_lock<std::mutex> lock(mutex);
+        int64_t t1 = nowMicros();
+        if (sharedSequence == lastSequence) {
+            lock.unlock();
+            std::this_thread::yield();
+            continue;
+        }
+        frame = shared.clone();
+        lastSequence = sharedSequence;
+        lock.unlock();
+        int64_t t2 = nowMicros();
+
+        result.consumerWait.add(static_cast<double>(t1 - t0));
+        result.consumerCopy.add(static_cast<double>(t2 - t1));
+        result.checksum += frame.data[0];
+        ++result.framesConsumed;
+    }
+    producer.join();
+    result.elapsedMs = (nowMicros() - start) / 1000.0;
+    return result;
+}
+
+// user-001：读入三缓冲的后台缓冲，交换原子索引发布，不拷贝
+Result runTripleBuffer(const cv::Mat& source, int frames) {
+    Result result;
+    TripleBuffer<cv::Mat> buffer;
+    std::atomic<bool> done{false};
+
+    int64_t start = nowMicros();
+    std::thread producer([&] {
+        for (int i = 1; i <= frames; ++i) {
+            readFrame(source, buffer.writeBuffer(), i);
+
+            int64_t t0 = nowMicros();
+            buffer.publish();
+            result.producerWait.add(static_cast<double>(nowMicros() - t0));
+            result.producerCopy.add(0.0);
+            ++result.framesProduced;
+        }
+        done = true;
+    });
+
+    while (!done) {
+        int64_t t0 = nowMicros();
+        bool fresh = buffer.update();
+        int64_t t1 = nowMicros();
+        if (!fresh) {
+            std::this_thread::yield();
+            continue;
+        }
+        result.consumerWait.add(static_cast<double>(t1 - t0));
+        result.consumerCopy.add(0.0);
+        result.checksum += buffer.readBuffer().data[0];
+        ++result.framesConsumed;
+    }
+    producer.join();
+    result.elapsedMs = (nowMicros() - start) / 1000.0;
+    return result;
+}
+
+// 当前实现：读入池槽位后发布，消费者按引用计数借用，不拷贝
+Result runFramePool(const cv::Mat& source, int frames) {
+    Result result;
+    FramePool pool;
+    if (!pool.initialize(POOL_SLOTS, FRAME_WIDTH, FRAME_HEIGHT, CV_8UC3, false)) {
+        std::fprintf(stderr, "[Bench] Failed to initialize frame pool\n");
+        std::exit(1);
+    }
+    std::atomic<bool> done{false};
+
+    int64_t start = nowMicros();
+    std::thread producer([&] {
+        for (int i = 1; i <= frames;) {
+            FrameSlot* slot = pool.acquireWritable();
+            if (!slot) {
+                std::this_thread::yield();
+                continue;
+            }
+            readFrame(source, slot->frame.image, i);
+            slot->frame.sequence = i;
+            slot->frame.timestampUs = nowMicros();
+
+            int64_t t0 = nowMicros();
+            pool.publish(slot);
+            result.producerWait.add(static_cast<double>(nowMicros() - t0));
+            result.producerCopy.add(0.0);
+            ++result.framesProduced;
+            ++i;
+        }
+        done = true;
+    });
+
+    uint64_t lastSequence = 0;
+    while (!done) {
+        if (pool.getLatestSequence() == lastSequence) {
+            std::this_thread::yield();
+            continue;
+        }
+        int64_t t0 = nowMicros();
+        FrameHandle frame = pool.acquireLatest();
+        result.consumerWait.add(static_cast<double>(nowMicros() - t0));
+        result.consumerCopy.add(0.0);
+        if (!frame) {
+            continue;
+        }
+        lastSequence = frame->sequence;
+        result.checksum += frame->image.data[0];
+        ++result.framesConsumed;
+    }
+    producer.join();
+    result.elapsedMs = (nowMicros() - start) / 1000.0;
+
+    FramePool::Stats stats = pool.getStats();
+    std::printf("[Bench] FramePool reallocations: %llu\n",
+                static_cast<unsigned long long>(stats.reallocations));
+    pool.release();
+    return result;
+}
+
+void printResult(const char* name, const Result& result) {
+    std::printf("%-13s %6llu/%-6llu %8.1f  copy %7.1f/%8.1f us  lock wait %6.1f/%8.1f us  "
+                "| consumer copy %7.1f/%8.1f us  lock wait %6.1f/%8.1f us\n",
+                name,
+                static_cast<unsigned long long>(result.framesConsumed),
+                static_cast<unsigned long long>(result.framesProduced),
+                result.elapsedMs,
+                result.producerCopy.averageUs(), result.producerCopy.maxUs,
+                result.producerWait.averageUs(), result.producerWait.maxUs,
+                result.consumerCopy.averageUs(), result.consumerCopy.maxUs,
+                result.consumerWait.averageUs(), result.consumerWait.maxUs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? std::max(std::atoi(argv[1]), 1) : DEFAULT_FRAMES;
+
+    cv::Mat source(FRAME_HEIGHT, FRAME_WIDTH, CV_8UC3);
+    cv::randu(source, cv::Scalar::all(0), cv::Scalar::all(255));
+
+    std::printf("[Bench] Frame handoff, %dx%d BGR, %d frames (avg/max per frame)\n",
+                FRAME_WIDTH, FRAME_HEIGHT, frames);
+    std::printf("%-13s %-13s %8s  producer\n", "method", "consumed/prod", "ms");
+
+    printResult("clone+mutex", runCloneMutex(source, frames));
+    printResult("TripleBuffer", runTripleBuffer(source, frames));
+    printResult("FramePool", runFramePool(source, frames));
+    return 0;
+}
@@ -1,85 +1,705 @@
 #include "CameraCapture.h"
+#include "FrameNotifier.h"
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace popcorn {
 
+namespace {
+
+// 看门狗检查间隔
+constexpr auto WATCHDOG_INTERVAL = std::chrono::milliseconds(100);
+
+// 重新连接失败后的重试间隔（指数退避）
+constexpr int64_t RECONNECT_MIN_DELAY_US = 500000;
+constexpr int64_t RECONNECT_MAX_DELAY_US = 8000000;
+
+// shutdown 等待后台线程退出的最长时间，超时后不再等待卡住的线程
+constexpr auto SHUTDOWN_GRACE = std::chrono::milliseconds(500);
+
+} // namespace
+
+const char* captureStateName(CaptureState state) {
+    switch (state) {
+        case CaptureState::Stopped:      return "stopped";
+        case CaptureState::Running:      return "running";
+        case CaptureState::Lost:         return "lost";
+        case CaptureState::Reconnecting: return "reconnecting";
+        case CaptureState::Finished:     return "finished";
+    }
+    return "unknown";
+}
+
+/**
+ * 一次连接
+ * 采集线程与看门狗以 CAS 争夺 phase：read 返回时 Blocked -> Idle 成功才继续，
+ * 看门狗 Blocked -> Abandoned 成功则该连接作废，返回的线程只归还槽位后退出
+ */
+struct CameraCapture::Connection {
+    enum Phase : int { Idle, Blocked, Abandoned };
+
+    std::unique_ptr<FrameSource> source;
+    bool live{false};                       // 实时设备才受看门狗监视
+
+    std::atomic<int> phase{Idle};
+    std::atomic<int64_t> blockedSinceUs{0}; // 进入 read / skip 的时刻
+
+    // 仅本连接的采集线程访问
+    cv::Rect crop;                          // 处理区域（像素；为空表示整帧）
+    cv::Size detectionImageSize;            // 实际检测图尺寸（保持宽高比）
+    cv::Mat detectionScratch;               // 缩放中间结果
+};
+
+/**
+ * 共享状态
+ * 后台线程各自持有引用：卡住的线程被放弃后 CameraCapture 可以立即关闭或销毁，
+ * 该线程返回时这里的帧池、统计等仍然有效
+ */
+struct CameraCapture::Core {
+    // 初始化后不变
+    SourceFactory factory;                  // 直接传入帧源时为空（无法重新连接）
+    FrameListener listener;
+    int detectionWidth{0};
+    int detectionHeight{0};
+    cv::Rect2f crop;                        // 归一化处理区域
+    int64_t stallTimeoutUs{0};
+
+    FramePool pool;                         // 采集线程 -> 消费者的无锁交接
+    FrameNotifier notifier;                 // 新帧通知；停止时中断等待和重试休眠
+    CaptureStats stats;
+    uint64_t nextSequence{1};               // 仅当前连接的采集线程访问
+
+    std::atomic<bool> running{true};
+    std::atomic<CaptureState> state{CaptureState::Running};
+    std::atomic<uint64_t> reconnects{0};
+
+    std::mutex connectionMutex;
+    std::shared_ptr<Connection> connection; // 当前连接
+    std::atomic<bool> supportsReconfigure{false};
+
+    // 由采集线程在模式切换时更新
+    std::atomic<int> width{0};
+    std::atomic<int> height{0};
+    std::atomic<double> fps{0.0};
+    std::atomic<int> detectionImageWidth{0};
+    std::atomic<int> detectionImageHeight{0};
+    std::atomic<int> cropX{0};
+    std::atomic<int> cropY{0};
+    std::atomic<int> cropWidth{0};
+    std::atomic<int> cropHeight{0};
+
+    // 挂起的采集模式切换请求
+    std::mutex modeMutex;
+    std::atomic<bool> modePending{false};
+    int pendingWidth{0};
+    int pendingHeight{0};
+    double pendingFps{0.0};
+
+    // 后台线程计数（shutdown 据此等待）与看门狗休眠
+    std::mutex threadMutex;
+    std::condition_variable threadCv;
+    int liveThreads{0};
+};
+
 CameraCapture::CameraCapture() = default;
 
 CameraCapture::~CameraCapture() {
     shutdown();
 }
 
+void CameraCapture::setBufferOptions(size_t slotCount, bool useHugePages) {
+    m_poolSlots = slotCount;
+    m_useHugePages = useHugePages;
+}
+
+void CameraCapture::setDetectionSize(int width, int height) {
+    m_detectionWidth = width;
+    m_detectionHeight = height;
+}
+
 bool CameraCapture::initialize(int deviceId, int width, int height) {
-    std::cout << "[Camera] Opening device " << deviceId << "...\n";
+    FrameSourceConfig config;
+    config.deviceId = deviceId;
+    config.width = width;
+    config.height = height;
+    return initialize(config);
+}
 
-    // 打开摄像头
-    m_capture.open(deviceId);
+bool CameraCapture::initialize(const FrameSourceConfig& config) {
+    if (config.detectionWidth > 0 && config.detectionHeight > 0) {
+        setDetectionSize(config.detectionWidth, config.detectionHeight);
+    }
+    if (config.crop != cv::Rect2f(0.0f, 0.0f, 1.0f, 1.0f)) {
+        setCrop(config.crop);
+    }
+    return start(createFrameSource(config), [config] { return createFrameSource(config); });
+}
+
+bool CameraCapture::initialize(std::unique_ptr<FrameSource> source) {
+    return start(std::move(source), nullptr);
+}
 
-    if (!m_capture.isOpened()) {
-        std::cerr << "[Camera] Failed to open camera " << deviceId << "\n";
+bool CameraCapture::start(std::unique_ptr<FrameSource> source, SourceFactory factory) {
+    if (!source) {
+        std::cerr << "[Camera] No frame source\n";
         return false;
     }
 
-    // 设置分辨率
-    m_capture.set(cv::CAP_PROP_FRAME_WIDTH, width);
-    m_capture.set(cv::CAP_PROP_FRAME_HEIGHT, height);
-    m_capture.set(cv::CAP_PROP_FPS, 30);
+    auto core = std::make_shared<Core>();
+    core->factory = std::move(factory);
+    core->listener = m_frameListener;
+    core->detectionWidth = m_detectionWidth;
+    core->detectionHeight = m_detectionHeight;
+    core->crop = m_crop;
+    core->stallTimeoutUs = static_cast<int64_t>(m_stallTimeoutMs) * 1000;
 
-    // 获取实际分辨率
-    m_width = static_cast<int>(m_capture.get(cv::CAP_PROP_FRAME_WIDTH));
-    m_height = static_cast<int>(m_capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+    // 打开帧源，获取实际分辨率，计算检测图尺寸
+    std::shared_ptr<Connection> connection = openConnection(*core, std::move(source));
+    if (!connection) {
+        return false;
+    }
 
-    std::cout << "[Camera] Opened at " << m_width << "x" << m_height << "\n";
+    std::cout << "[Camera] Source " << connection->source->getName() << " at "
+              << core->width << "x" << core->height << "\n";
 
-    m_isOpened = true;
-    m_running = true;
+    // 按实际分辨率和像素格式预分配帧池
+    PixelFormat format = connection->source->getPixelFormat();
+    cv::Size poolSize = pixelFormatMatSize(format, core->width.load(), core->height.load());
+    if (!core->pool.initialize(m_poolSlots, poolSize.width, poolSize.height,
+                               pixelFormatMatType(format), m_useHugePages)) {
+        std::cerr << "[Camera] Failed to allocate frame pool\n";
+        return false;
+    }
 
-    // 启动采集线程
-    m_thread = std::thread(&CameraCapture::captureThread, this);
+    core->stats.reset(core->fps);
+
+    {
+        std::lock_guard<std::mutex> lock(core->connectionMutex);
+        core->connection = connection;
+    }
+    m_core = core;
+
+    // 启动采集线程；实时设备额外启动看门狗
+    spawnThread(core, [core, connection] { captureThread(core, connection); });
+    if (connection->live && core->stallTimeoutUs > 0) {
+        spawnThread(core, [core] { watchdogThread(core); });
+    }
 
     return true;
 }
 
+std::shared_ptr<CameraCapture::Connection> CameraCapture::openConnection(Core& core,
+                                                                          std::unique_ptr<FrameSource> source) {
+    source->setDetectionSize(core.detectionWidth, core.detectionHeight);
+    if (!source->open()) {
+        std::cerr << "[Camera] Failed to open source " << source->getName() << "\n";
+        return nullptr;
+    }
+
+    auto connection = std::make_shared<Connection>();
+    connection->source = std::move(source);
+    connection->live = connection->source->isLive();
+    updateGeometry(core, *connection);
+    core.supportsReconfigure = connection->source->supportsReconfigure();
+    return connection;
+}
+
+void CameraCapture::spawnThread(const std::shared_ptr<Core>& core, std::function<void()> body) {
+    {
+        std::lock_guard<std::mutex> lock(core->threadMutex);
+        ++core->liveThreads;
+    }
+
+    // 分离运行：卡在 read 中的线程无法 join，它持有的 core 引用保证返回后仍可安全访问
+    std::thread([core, body = std::move(body)] {
+        body();
+        std::lock_guard<std::mutex> lock(core->threadMutex);
+        --core->liveThreads;
+        core->threadCv.notify_all();
+    }).detach();
+}
+
+void CameraCapture::updateGeometry(Core& core, Connection& connection) {
+    int width = connection.source->getWidth();
+    int height = connection.source->getHeight();
+    core.width = width;
+    core.height = height;
+    core.fps = connection.source->getFps();
+
+    // 处理区域：向外取整到偶数像素（YUYV 按像素对、NV12 按 2x2 块存储色度），至少 2x2
+    const cv::Rect2f& crop = core.crop;
+    int left = std::max(static_cast<int>(std::floor(crop.x * width)), 0) & ~1;
+    int top = std::max(static_cast<int>(std::floor(crop.y * height)), 0) & ~1;
+    int right = std::min((static_cast<int>(std::ceil((crop.x + crop.width) * width)) + 1) & ~1, width);
+    int bottom = std::min((static_cast<int>(std::ceil((crop.y + crop.height) * height)) + 1) & ~1, height);
+    cv::Rect region(0, 0, width, height);
+    if (right - left >= 2 && bottom - top >= 2) {
+        region = cv::Rect(left, top, right - left, bottom - top);
+    } else {
+        std::cerr << "[Camera] Crop region is empty, processing full frame\n";
+    }
+    bool cropped = region.width != width || region.height != height;
+    if (cropped) {
+        std::cout << "[Camera] Crop " << region.width << "x" << region.height << " at ("
+                  << region.x << ", " << region.y << ")\n";
+    }
+    connection.crop = cropped ? region : cv::Rect();
+    core.cropX = region.x;
+    core.cropY = region.y;
+    core.cropWidth = region.width;
+    core.cropHeight = region.height;
+
+    // 检测图：保持处理区域的宽高比，缩小到恰好覆盖检测器输入尺寸（YUV 转换要求偶数宽高）
+    cv::Size detectionImageSize;
+    if (core.detectionWidth > 0 && core.detectionHeight > 0) {
+        double scale = std::min(1.0, std::max(static_cast<double>(core.detectionWidth) / region.width,
+                                              static_cast<double>(core.detectionHeight) / region.height));
+        int detectionWidth = static_cast<int>(std::lround(region.width * scale)) & ~1;
+        int detectionHeight = static_cast<int>(std::lround(region.height * scale)) & ~1;
+        detectionImageSize = cv::Size(std::max(detectionWidth, 2), std::max(detectionHeight, 2));
+        std::cout << "[Camera] Detection image " << detectionImageSize.width << "x"
+                  << detectionImageSize.height << " RGB\n";
+    }
+    connection.detectionImageSize = detectionImageSize;
+    core.detectionImageWidth = detectionImageSize.width;
+    core.detectionImageHeight = detectionImageSize.height;
+}
+
+void CameraCapture::requestCaptureMode(int width, int height, double fps) {
+    if (!m_core) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_core->modeMutex);
+    m_core->pendingWidth = width;
+    m_core->pendingHeight = height;
+    m_core->pendingFps = fps;
+    m_core->modePending.store(true, std::memory_order_release);
+}
+
+void CameraCapture::applyCaptureMode(Core& core, Connection& connection) {
+    int width = 0;
+    int height = 0;
+    double fps = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(core.modeMutex);
+        width = core.pendingWidth;
+        height = core.pendingHeight;
+        fps = core.pendingFps;
+        core.modePending.store(false, std::memory_order_relaxed);
+    }
+
+    FrameSource& source = *connection.source;
+    if (!source.supportsReconfigure()) {
+        return;
+    }
+    if (width == core.width && height == core.height && fps == core.fps) {
+        return;
+    }
+
+    int64_t start = nowMicros();
+    bool ok = source.reconfigure(width, height, fps);
+
+    // 失败时帧源可能退回了原模式，也可能停在其他模式：一律以实际模式为准
+    updateGeometry(core, connection);
+    PixelFormat format = source.getPixelFormat();
+    cv::Size poolSize = pixelFormatMatSize(format, core.width.load(), core.height.load());
+    core.pool.reformat(poolSize.width, poolSize.height, pixelFormatMatType(format));
+    core.stats.setNominalFps(core.fps);
+
+    std::cout << "[Camera] Capture mode " << (ok ? "switched" : "switch failed") << ": "
+              << core.width << "x" << core.height << " @ " << core.fps << "fps ("
+              << (nowMicros() - start) / 1000 << "ms)\n";
+}
+
 void CameraCapture::shutdown() {
-    m_running = false;
+    if (!m_core) {
+        return;
+    }
 
-    if (m_thread.joinable()) {
-        m_thread.join();
+    std::shared_ptr<Core> core = std::move(m_core);
+    core->running = false;
+    core->notifier.interrupt();
+
+    // 与看门狗相同：放弃正阻塞在 read 中的连接，它返回后不再调用监听器或发布帧
+    std::shared_ptr<Connection> connection;
+    {
+        std::lock_guard<std::mutex> connectionLock(core->connectionMutex);
+        connection = core->connection;
+    }
+    if (connection) {
+        int expected = Connection::Blocked;
+        connection->phase.compare_exchange_strong(expected, Connection::Abandoned,
+                                                  std::memory_order_acq_rel);
     }
 
-    if (m_capture.isOpened()) {
-        m_capture.release();
+    // 正常情况下采集线程在当前 read 返回后即退出；卡住的线程不再等待，由它返回后自行清理
+    std::unique_lock<std::mutex> lock(core->threadMutex);
+    core->threadCv.notify_all();
+    if (!core->threadCv.wait_for(lock, SHUTDOWN_GRACE, [&] { return core->liveThreads == 0; })) {
+        std::cerr << "[Camera] " << core->liveThreads << " thread(s) still blocked, detached\n";
     }
+    lock.unlock();
 
-    m_isOpened = false;
+    core->state = CaptureState::Stopped;
     std::cout << "[Camera] Shutdown complete\n";
 }
 
-void CameraCapture::captureThread() {
+void CameraCapture::captureThread(std::shared_ptr<Core> core, std::shared_ptr<Connection> connection) {
     std::cout << "[Camera] Capture thread started\n";
 
-    cv::Mat frame;
-    while (m_running) {
-        if (m_capture.read(frame)) {
-            std::lock_guard<std::mutex> lock(m_frameMutex);
-            m_currentFrame = frame.clone();
+    FrameSource& source = *connection->source;
+    uint64_t failureStreak = 0;
+    uint64_t nextFailureReport = 1;
+    int64_t failureStartUs = 0;
+
+    // 进入 / 离开可能阻塞的调用；离开时返回 false 表示本连接已被看门狗放弃
+    auto beginBlocking = [&](int64_t now) {
+        connection->blockedSinceUs.store(now, std::memory_order_relaxed);
+        connection->phase.store(Connection::Blocked, std::memory_order_release);
+    };
+    auto endBlocking = [&] {
+        int expected = Connection::Blocked;
+        return connection->phase.compare_exchange_strong(expected, Connection::Idle,
+                                                         std::memory_order_acq_rel);
+    };
+
+    while (core->running) {
+        // 模式切换只在两帧之间进行，此时采集线程不持有任何槽位
+        if (core->modePending.load(std::memory_order_acquire)) {
+            applyCaptureMode(*core, *connection);
+        }
+
+        FrameSlot* slot = core->pool.acquireWritable();
+        if (!slot) {
+            // 所有槽位都被借出：丢弃这一帧，只从驱动队列中取出以免积压
+            beginBlocking(nowMicros());
+            bool skipped = source.skip();
+            if (!endBlocking()) {
+                break;
+            }
+            if (!skipped) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            continue;
+        }
+
+        // 直接读入池缓冲，帧源负责填写采集时间戳
+        int64_t readStart = nowMicros();
+        beginBlocking(readStart);
+        bool ok = source.read(slot->frame);
+        if (!endBlocking()) {
+            // 看门狗已放弃本连接并可能已在重新连接：只归还槽位，不再发布
+            core->pool.discard(slot);
+            std::cout << "[Camera] Abandoned read returned after "
+                      << (nowMicros() - readStart) / 1000 << "ms\n";
+            break;
+        }
+        core->stats.recordRead(nowMicros() - readStart, ok, slot->frame.timestampUs);
+
+        if (!core->running) {
+            // read 期间已关闭：shutdown 可能已返回，监听器的持有者随时会被销毁
+            core->pool.discard(slot);
+            break;
+        }
+
+        if (ok) {
+            if (failureStreak > 0) {
+                std::cout << "[Camera] Recovered after " << failureStreak << " failed reads ("
+                          << (nowMicros() - failureStartUs) / 1000 << "ms)\n";
+                failureStreak = 0;
+                nextFailureReport = 1;
+            }
+
+            slot->frame.crop = connection->crop;
+            prepareDetectionImage(*connection, slot->frame);
+            slot->frame.sequence = core->nextSequence++;
+            if (core->listener) {
+                core->listener(slot->frame);
+            }
+            uint64_t sequence = slot->frame.sequence;
+            core->pool.publish(slot);
+            core->notifier.notify(sequence);
         } else {
-            // 读取失败，短暂休眠后重试
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            core->pool.discard(slot);
+
+            if (source.isFinished()) {
+                std::cout << "[Camera] Source finished\n";
+                core->state = CaptureState::Finished;
+                core->notifier.interrupt();
+                break;
+            }
+
+            // 连续失败时按 1、10、100... 次报告，避免刷屏
+            if (failureStreak++ == 0) {
+                failureStartUs = readStart;
+            }
+            if (failureStreak == nextFailureReport) {
+                std::cerr << "[Camera] Read failed (" << failureStreak << " consecutive)\n";
+                nextFailureReport *= 10;
+            }
+
+            // 实时设备持续失败（如被拔出）：放弃本连接，交给看门狗重新连接
+            if (connection->live && core->factory && core->stallTimeoutUs > 0 &&
+                readStart - failureStartUs > core->stallTimeoutUs) {
+                std::cerr << "[Camera] Reads failing for " << (readStart - failureStartUs) / 1000
+                          << "ms, camera lost\n";
+                connection->phase.store(Connection::Abandoned, std::memory_order_relaxed);
+                core->state.store(CaptureState::Lost, std::memory_order_release);
+                break;
+            }
+
+            // 读取失败，短暂休眠后重试（shutdown 时立即醒来）
+            core->notifier.sleep(10000);
         }
     }
 
+    // 帧源只由本线程使用，在这里关闭（被放弃的连接也是在 read 返回之后）
+    source.close();
     std::cout << "[Camera] Capture thread ended\n";
 }
 
-bool CameraCapture::getFrame(cv::Mat& frame) {
-    std::lock_guard<std::mutex> lock(m_frameMutex);
+void CameraCapture::watchdogThread(std::shared_ptr<Core> core) {
+    int64_t retryDelayUs = RECONNECT_MIN_DELAY_US;
+    int64_t nextRetryUs = 0;
+
+    std::unique_lock<std::mutex> lock(core->threadMutex);
+    while (core->running) {
+        core->threadCv.wait_for(lock, WATCHDOG_INTERVAL);
+        if (!core->running) {
+            break;
+        }
+        lock.unlock();
+
+        int64_t now = nowMicros();
+        CaptureState state = core->state.load(std::memory_order_acquire);
+
+        if (state == CaptureState::Running) {
+            // read 阻塞超时：放弃本连接（采集线程返回时会发现并退出）
+            std::shared_ptr<Connection> connection;
+            {
+                std::lock_guard<std::mutex> connectionLock(core->connectionMutex);
+                connection = core->connection;
+            }
+            // 先读 phase 再读时刻：看到 Blocked 时读到的时刻不早于本次阻塞的开始
+            bool blocked = connection->phase.load(std::memory_order_acquire) == Connection::Blocked;
+            int64_t since = connection->blockedSinceUs.load(std::memory_order_relaxed);
+            int expected = Connection::Blocked;
+            if (blocked && now - since > core->stallTimeoutUs &&
+                connection->phase.compare_exchange_strong(expected, Connection::Abandoned,
+                                                          std::memory_order_acq_rel)) {
+                std::cerr << "[Camera] Read blocked for " << (now - since) / 1000 << "ms, camera lost\n";
+                core->state = CaptureState::Lost;
+                state = CaptureState::Lost;
+                nextRetryUs = now;
+            }
+        }
+
+        if (state == CaptureState::Lost && core->factory && now >= nextRetryUs) {
+            // 在看门狗线程中重新打开设备（可能耗时数秒），不影响主线程和已发布的帧
+            core->state = CaptureState::Reconnecting;
+            std::cout << "[Camera] Reconnecting...\n";
+
+            std::unique_ptr<FrameSource> source = core->factory();
+            std::shared_ptr<Connection> connection = source ? openConnection(*core, std::move(source)) : nullptr;
+            if (!core->running) {
+                lock.lock();
+                break;
+            }
+
+            if (connection) {
+                // 旧连接的采集线程已退出或已被放弃，此时没有生产者：可以直接切换帧池格式
+                PixelFormat format = connection->source->getPixelFormat();
+                cv::Size poolSize = pixelFormatMatSize(format, core->width.load(), core->height.load());
+                core->pool.reformat(poolSize.width, poolSize.height, pixelFormatMatType(format));
+                core->stats.setNominalFps(core->fps);
+                {
+                    std::lock_guard<std::mutex> connectionLock(core->connectionMutex);
+                    core->connection = connection;
+                }
+
+                core->reconnects.fetch_add(1, std::memory_order_relaxed);
+                core->state = CaptureState::Running;
+                retryDelayUs = RECONNECT_MIN_DELAY_US;
+                std::cout << "[Camera] Reconnected to " << connection->source->getName() << " at "
+                          << core->width << "x" << core->height << "\n";
+                spawnThread(core, [core, connection] { captureThread(core, connection); });
+            } else {
+                // 被放弃的线程可能仍占用设备：退避后重试
+                core->state = CaptureState::Lost;
+                nextRetryUs = nowMicros() + retryDelayUs;
+                std::cerr << "[Camera] Reconnect failed, retrying in " << retryDelayUs / 1000 << "ms\n";
+                retryDelayUs = std::min(retryDelayUs * 2, RECONNECT_MAX_DELAY_US);
+            }
+        }
+
+        lock.lock();
+    }
+}
+
+void CameraCapture::prepareDetectionImage(Connection& connection, CameraFrame& frame) {
+    if (connection.detectionImageSize.empty()) {
+        return;
+    }
+
+    const cv::Size& size = connection.detectionImageSize;
+    cv::Mat& scratch = connection.detectionScratch;
+
+    // 帧源已顺带生成了缩小图（如 MJPEG 缩放解码）：只需小图之间的缩放，处理区域按比例换算
+    if (const cv::Mat* reduced = connection.source->getReducedImage()) {
+        cv::Mat source = *reduced;
+        if (!frame.crop.empty()) {
+            double sx = static_cast<double>(reduced->cols) / frame.width();
+            double sy = static_cast<double>(reduced->rows) / frame.height();
+            int x = static_cast<int>(frame.crop.x * sx);
+            int y = static_cast<int>(frame.crop.y * sy);
+            int width = std::min(std::max(static_cast<int>(std::lround(frame.crop.width * sx)), 1), reduced->cols - x);
+            int height = std::min(std::max(static_cast<int>(std::lround(frame.crop.height * sy)), 1), reduced->rows - y);
+            source = (*reduced)(cv::Rect(x, y, width, height));
+        }
+        cv::resize(source, scratch, size, 0, 0, cv::INTER_AREA);
+        cv::cvtColor(scratch, frame.detectionImage, cv::COLOR_BGR2RGB);
+        return;
+    }
+
+    // 先在原始格式下缩小，再在小图上做颜色转换；只读处理区域内的像素
+    switch (frame.format) {
+        case PixelFormat::YUYV: {
+            // 每 4 字节（Y0 U Y1 V）视为一个像素，缩放结果仍是合法的 YUYV
+            cv::Mat region = frameRegion(frame);
+            cv::Mat packed(region.rows, region.cols / 2, CV_8UC4, region.data, region.step);
+            cv::resize(packed, scratch, cv::Size(size.width / 2, size.height), 0, 0, cv::INTER_AREA);
+            cv::Mat yuyv(size.height, size.width, CV_8UC2, scratch.data, scratch.step);
+            cv::cvtColor(yuyv, frame.detectionImage, cv::COLOR_YUV2RGB_YUYV);
+            break;
+        }
 
-    if (m_currentFrame.empty()) {
+        case PixelFormat::NV12: {
+            // Y 平面与 UV 平面分别缩放到小 NV12 图的对应位置
+            cv::Mat srcY;
+            cv::Mat srcUV;
+            frameRegionNV12(frame, srcY, srcUV);
+
+            scratch.create(size.height * 3 / 2, size.width, CV_8UC1);
+            cv::Mat dstY = scratch.rowRange(0, size.height);
+            cv::Mat dstUV(size.height / 2, size.width / 2, CV_8UC2,
+                          scratch.ptr(size.height), scratch.step);
+            cv::resize(srcY, dstY, dstY.size(), 0, 0, cv::INTER_AREA);
+            cv::resize(srcUV, dstUV, dstUV.size(), 0, 0, cv::INTER_AREA);
+            cv::cvtColor(scratch, frame.detectionImage, cv::COLOR_YUV2RGB_NV12);
+            break;
+        }
+
+        default:
+            cv::resize(frameRegion(frame), scratch, size, 0, 0, cv::INTER_AREA);
+            cv::cvtColor(scratch, frame.detectionImage, cv::COLOR_BGR2RGB);
+            break;
+    }
+}
+
+bool CameraCapture::supportsReconfigure() const {
+    return m_core && m_core->supportsReconfigure.load(std::memory_order_relaxed);
+}
+
+int CameraCapture::getFrameEventFd() {
+    return m_core ? m_core->notifier.getEventFd() : -1;
+}
+
+void CameraCapture::clearFrameEvent() {
+    if (m_core) {
+        m_core->notifier.clearEvent();
+    }
+}
+
+uint64_t CameraCapture::getLatestSequence() const {
+    return m_core ? m_core->pool.getLatestSequence() : 0;
+}
+
+FramePool::Stats CameraCapture::getBufferStats() const {
+    return m_core ? m_core->pool.getStats() : FramePool::Stats{};
+}
+
+CaptureStats::Snapshot CameraCapture::getCaptureStats() const {
+    if (!m_core) {
+        return CaptureStats::Snapshot{};
+    }
+    CaptureStats::Snapshot stats = m_core->stats.snapshot();
+    FramePool::Stats pool = m_core->pool.getStats();
+    stats.droppedUnconsumed = pool.unconsumed;
+    stats.droppedPoolFull = pool.exhausted;
+    return stats;
+}
+
+int CameraCapture::getWidth() const {
+    return m_core ? m_core->width.load(std::memory_order_relaxed) : 0;
+}
+
+int CameraCapture::getHeight() const {
+    return m_core ? m_core->height.load(std::memory_order_relaxed) : 0;
+}
+
+double CameraCapture::getFps() const {
+    return m_core ? m_core->fps.load(std::memory_order_relaxed) : 0.0;
+}
+
+cv::Size CameraCapture::getDetectionImageSize() const {
+    if (!m_core) {
+        return cv::Size();
+    }
+    return cv::Size(m_core->detectionImageWidth.load(std::memory_order_relaxed),
+                    m_core->detectionImageHeight.load(std::memory_order_relaxed));
+}
+
+cv::Rect CameraCapture::getCropRegion() const {
+    if (!m_core) {
+        return cv::Rect();
+    }
+    return cv::Rect(m_core->cropX.load(std::memory_order_relaxed), m_core->cropY.load(std::memory_order_relaxed),
+                    m_core->cropWidth.load(std::memory_order_relaxed),
+                    m_core->cropHeight.load(std::memory_order_relaxed));
+}
+
+CaptureState CameraCapture::getState() const {
+    return m_core ? m_core->state.load(std::memory_order_acquire) : CaptureState::Stopped;
+}
+
+uint64_t CameraCapture::getReconnectCount() const {
+    return m_core ? m_core->reconnects.load(std::memory_order_relaxed) : 0;
+}
+
+bool CameraCapture::getFrame(FrameHandle& frame) {
+    if (!m_core) {
+        return false;
+    }
+    frame = m_core->pool.acquireLatest();
+    return static_cast<bool>(frame);
+}
+
+bool CameraCapture::waitForFrame(FrameHandle& frame, uint64_t lastSequence, int timeoutMs) {
+    if (!m_core) {
+        return false;
+    }
+    int64_t timeoutUs = timeoutMs < 0 ? -1 : static_cast<int64_t>(timeoutMs) * 1000;
+    if (!m_core->notifier.wait(lastSequence, timeoutUs)) {
         return false;
     }
+    return getNewFrame(frame, lastSequence);
+}
 
-    frame = m_currentFrame.clone();
+bool CameraCapture::getNewFrame(FrameHandle& frame, uint64_t lastSequence) {
+    // 快速路径：没有新发布的帧时不触碰帧池
+    if (getLatestSequence() <= lastSequence) {
+        return false;
+    }
+
+    if (!getFrame(frame) || frame->sequence <= lastSequence) {
+        frame.reset();
+        return false;
+    }
     return true;
 }
 
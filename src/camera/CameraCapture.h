@@ -2,20 +2,93 @@
 
 #include <opencv2/opencv.hpp>
 #include <atomic>
-#include <thread>
-#include <mutex>
+#include <functional>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "CameraFrame.h"
+#include "CaptureStats.h"
+#include "FramePool.h"
+#include "FrameSource.h"
 
 namespace popcorn {
 
+/**
+ * 采集状态
+ */
+enum class CaptureState {
+    Stopped,        // 未初始化或已关闭
+    Running,        // 正常采集
+    Lost,           // read 卡住或持续失败，连接已放弃
+    Reconnecting,   // 正在后台重新打开帧源
+    Finished        // 不循环的文件回放已播完
+};
+
+/**
+ * 采集状态名称（用于日志）
+ */
+const char* captureStateName(CaptureState state);
+
 /**
  * 摄像头采集类
- * 使用 OpenCV 进行跨平台摄像头采集
+ * 在后台线程从 FrameSource（实时摄像头或文件回放）读取帧
+ *
+ * 采集线程直接读入预分配帧池中的空闲槽位并发布，
+ * 消费者以引用计数借用最新帧，整条路径无逐帧拷贝、无互斥锁、稳态无堆分配。
+ *
+ * 设置了检测尺寸时，每帧同时发布显示用的原始图像和检测用的低分辨率 RGB 图，
+ * 缩放与颜色转换在采集线程中只做一次，检测器不再接触全分辨率像素。
+ *
+ * 看门狗线程监视 read：USB 摄像头出错时 read 可能卡住数秒，超时后放弃该连接
+ * （状态变为 Lost），在后台重新打开设备并启动新的采集线程，恢复后回到 Running。
+ * 被放弃的线程只持有共享状态的引用，返回后自行退出；shutdown 不会因它而阻塞。
  */
 class CameraCapture {
 public:
+    /**
+     * 逐帧回调（在采集线程中、帧发布之前调用；必须立即返回，不得保存帧的引用）
+     */
+    using FrameListener = std::function<void(const CameraFrame&)>;
+
     CameraCapture();
     ~CameraCapture();
 
+    /**
+     * 设置帧池参数（需在 initialize 之前调用）
+     * @param slotCount 预分配的帧槽位数
+     * @param useHugePages 尝试使用大页内存（仅 Linux）
+     */
+    void setBufferOptions(size_t slotCount, bool useHugePages);
+
+    /**
+     * 设置检测器输入尺寸（需在 initialize 之前调用）
+     * 检测图按原始宽高比缩小到恰好覆盖该尺寸；传 0 表示不生成检测图
+     * @param width 检测器输入宽度
+     * @param height 检测器输入高度
+     */
+    void setDetectionSize(int width, int height);
+
+    /**
+     * 设置处理区域（需在 initialize 之前调用）
+     * 每帧只有该区域参与检测图生成、检测和纹理上传（见 CameraFrame::crop），
+     * 帧池仍按整帧读取，裁剪本身不拷贝像素；检测图按区域的宽高比生成
+     * @param crop 相对整帧的归一化区域，默认 (0, 0, 1, 1) 为不裁剪
+     */
+    void setCrop(const cv::Rect2f& crop) { m_crop = crop; }
+
+    /**
+     * 设置逐帧回调（需在 initialize 之前调用），如会话录制
+     * 每个成功读取的帧都会经过回调，包括之后未被任何消费者取走的帧
+     */
+    void setFrameListener(FrameListener listener) { m_frameListener = std::move(listener); }
+
+    /**
+     * 设置看门狗超时（需在 initialize 之前调用）
+     * 一次 read 阻塞超过该时长、或连续读取失败超过该时长，即判定摄像头断开并重新连接
+     * @param timeoutMs 超时（毫秒），0 表示关闭看门狗
+     */
+    void setStallTimeout(int timeoutMs) { m_stallTimeoutMs = timeoutMs; }
+
     /**
      * 初始化摄像头
      * @param deviceId 设备 ID（通常为 0）
@@ -26,43 +99,176 @@ public:
     bool initialize(int deviceId, int width, int height);
 
     /**
-     * 关闭摄像头
+     * 按配置初始化（摄像头、视频文件或图片序列）
+     * @param config 帧源配置
+     * @return 成功返回 true
+     */
+    bool initialize(const FrameSourceConfig& config);
+
+    /**
+     * 使用指定帧源初始化
+     * 没有配置可用于重新创建帧源，看门狗只能判定断开，不会重新连接
+     * @param source 帧源（接管所有权）
+     * @return 成功返回 true
+     */
+    bool initialize(std::unique_ptr<FrameSource> source);
+
+    /**
+     * 关闭摄像头（不阻塞：卡在 read 中的线程被放弃，返回后自行退出）
      */
     void shutdown();
 
     /**
-     * 获取当前帧
-     * @param frame 输出帧
+     * 帧源是否支持运行时切换分辨率和帧率
+     */
+    bool supportsReconfigure() const;
+
+    /**
+     * 请求切换采集分辨率和帧率（任意线程，异步生效）
+     * 采集线程在两帧之间重新协商帧源，帧池槽位按新尺寸逐个重建，
+     * 已借出的帧不受影响；之后发布的帧以新尺寸为准（见 CameraFrame::width/height）
+     * @param width 期望宽度
+     * @param height 期望高度
+     * @param fps 期望帧率
+     */
+    void requestCaptureMode(int width, int height, double fps);
+
+    /**
+     * 借用最新帧（可多线程调用）
+     * 句柄持有期间该帧不会被覆盖，不复制像素；
+     * 请尽快释放句柄，长期持有会占用池槽位
+     * @param frame 输出帧句柄（含序号和采集时间戳）
      * @return 成功返回 true
      */
-    bool getFrame(cv::Mat& frame);
+    bool getFrame(FrameHandle& frame);
+
+    /**
+     * 仅当存在比 lastSequence 更新的帧时才返回该帧
+     * 下游可据此跳过对重复帧的检测、上传等处理
+     * @param frame 输出帧句柄
+     * @param lastSequence 调用方已处理过的最新帧序号
+     * @return 有新帧返回 true
+     */
+    bool getNewFrame(FrameHandle& frame, uint64_t lastSequence);
+
+    /**
+     * 阻塞等待比 lastSequence 更新的帧（可多线程调用）
+     * 帧发布时立即唤醒，不轮询；适合独立的检测线程
+     * @param frame 输出帧句柄
+     * @param lastSequence 调用方已处理过的最新帧序号
+     * @param timeoutMs 超时（毫秒），负数表示一直等待
+     * @return 有新帧返回 true；超时、采集停止或帧源播放完毕返回 false
+     */
+    bool waitForFrame(FrameHandle& frame, uint64_t lastSequence, int timeoutMs);
+
+    /**
+     * 新帧 eventfd，可与其他 fd 一起 poll / epoll（仅 Linux，其他平台返回 -1）
+     * 可读表示有新帧或采集已停止；读出后调用 clearFrameEvent()，再用 getNewFrame 取帧
+     */
+    int getFrameEventFd();
+    void clearFrameEvent();
+
+    /**
+     * 获取最新已发布帧的序号（0 表示尚无帧）
+     */
+    uint64_t getLatestSequence() const;
+
+    /**
+     * 获取帧池统计（分配次数等，用于验证稳态零分配）
+     */
+    FramePool::Stats getBufferStats() const;
+
+    /**
+     * 获取采集遥测（read 阻塞时间、帧间隔抖动、丢帧、读取失败；任意线程）
+     * 累计值；两次快照用 since() 相减即得区间统计
+     */
+    CaptureStats::Snapshot getCaptureStats() const;
 
     /**
      * 获取实际分辨率
      */
-    int getWidth() const { return m_width; }
-    int getHeight() const { return m_height; }
+    int getWidth() const;
+    int getHeight() const;
+
+    /**
+     * 获取帧源标称帧率
+     */
+    double getFps() const;
+
+    /**
+     * 获取检测图尺寸（未生成时为空）
+     */
+    cv::Size getDetectionImageSize() const;
+
+    /**
+     * 获取处理区域（原始帧像素坐标；未裁剪时为整帧）
+     */
+    cv::Rect getCropRegion() const;
 
     /**
      * 摄像头是否打开
      */
-    bool isOpened() const { return m_isOpened; }
+    bool isOpened() const { return static_cast<bool>(m_core); }
+
+    /**
+     * 帧源是否已播放完毕（不循环的文件回放）
+     */
+    bool isFinished() const { return getState() == CaptureState::Finished; }
+
+    /**
+     * 获取采集状态（任意线程）
+     */
+    CaptureState getState() const;
+
+    /**
+     * 看门狗重新连接成功的次数
+     */
+    uint64_t getReconnectCount() const;
 
 private:
+    // 采集线程、看门狗线程与 CameraCapture 共享的状态（见 CameraCapture.cpp）
+    struct Core;
+    // 一次连接：帧源及其采集线程的状态
+    struct Connection;
+
+    // 重新连接时创建帧源
+    using SourceFactory = std::function<std::unique_ptr<FrameSource>()>;
+
+    // 打开帧源、建立帧池并启动采集线程和看门狗
+    bool start(std::unique_ptr<FrameSource> source, SourceFactory factory);
+
+    // 打开帧源并按其实际模式更新尺寸（initialize 与重新连接共用）
+    static std::shared_ptr<Connection> openConnection(Core& core, std::unique_ptr<FrameSource> source);
+
+    // 启动一个共享状态的后台线程（分离运行，退出时计数减一）
+    static void spawnThread(const std::shared_ptr<Core>& core, std::function<void()> body);
+
     // 采集线程函数
-    void captureThread();
+    static void captureThread(std::shared_ptr<Core> core, std::shared_ptr<Connection> connection);
 
-private:
-    cv::VideoCapture m_capture;
-    cv::Mat m_currentFrame;
-    std::mutex m_frameMutex;
+    // 看门狗线程函数：检测卡住的 read，断开后重新连接
+    static void watchdogThread(std::shared_ptr<Core> core);
+
+    // 为刚读入的帧生成检测图（采集线程）
+    static void prepareDetectionImage(Connection& connection, CameraFrame& frame);
+
+    // 按帧源当前的实际模式更新分辨率、帧率、处理区域和检测图尺寸
+    static void updateGeometry(Core& core, Connection& connection);
 
-    std::thread m_thread;
-    std::atomic<bool> m_running{false};
-    std::atomic<bool> m_isOpened{false};
+    // 执行挂起的采集模式切换（采集线程）
+    static void applyCaptureMode(Core& core, Connection& connection);
+
+private:
+    std::shared_ptr<Core> m_core;         // initialize 之前和 shutdown 之后为空
 
-    int m_width{0};
-    int m_height{0};
+    // initialize 之前设置的参数
+    FrameListener m_frameListener;
+    size_t m_poolSlots{6};
+    bool m_useHugePages{false};
+    int m_detectionWidth{0};
+    int m_detectionHeight{0};
+    cv::Rect2f m_crop{0.0f, 0.0f, 1.0f, 1.0f};
+    int m_stallTimeoutMs{2000};
 };
 
 } // namespace popcorn
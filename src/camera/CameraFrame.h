@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <opencv2/opencv.hpp>
+
+namespace popcorn {
+
+/**
+ * 帧像素格式
+ */
+enum class PixelFormat {
+    BGR,    // CV_8UC3，OpenCV 默认
+    YUYV,   // CV_8UC2，4:2:2 打包（Y0 U Y1 V）
+    NV12    // CV_8UC1，高度为 1.5 倍：Y 平面后接交错的 UV 平面
+};
+
+/**
+ * 某像素格式对应的 OpenCV 类型
+ */
+inline int pixelFormatMatType(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::YUYV: return CV_8UC2;
+        case PixelFormat::NV12: return CV_8UC1;
+        default:                return CV_8UC3;
+    }
+}
+
+/**
+ * 某像素格式下宽高为 width x height 的图像对应的 Mat 行列数
+ */
+inline cv::Size pixelFormatMatSize(PixelFormat format, int width, int height) {
+    if (format == PixelFormat::NV12) {
+        return cv::Size(width, height * 3 / 2);
+    }
+    return cv::Size(width, height);
+}
+
+/**
+ * 摄像头帧描述
+ * 携带单调递增的序号和采集时间戳，下游据此判断是否为新帧
+ * image 用于显示，detectionImage 由采集线程一次生成，供所有检测器共用
+ */
+struct CameraFrame {
+    cv::Mat image;              // 图像数据（格式见 format）
+    PixelFormat format{PixelFormat::BGR};
+    cv::Mat detectionImage;     // 检测用的低分辨率 RGB 图（保持宽高比；未配置检测尺寸时为空）
+    cv::Rect crop;              // 裁剪区域（原始帧像素坐标，x / y / 宽高均为偶数；为空表示整帧）
+    uint64_t sequence{0};       // 帧序号，从 1 开始单调递增；0 表示无效帧
+    int64_t timestampUs{0};     // 采集时间戳（steady_clock，微秒）
+
+    // 外部缓冲的持有者：非空时 image 指向帧源自己的内存（零拷贝），
+    // 持有者存活期间该内存保持有效
+    std::shared_ptr<void> owner;
+
+    bool valid() const { return sequence != 0 && !image.empty(); }
+
+    /**
+     * 图像实际宽高（NV12 的 Mat 行数包含 UV 平面）
+     */
+    int width() const { return image.cols; }
+    int height() const { return format == PixelFormat::NV12 ? image.rows * 2 / 3 : image.rows; }
+
+    /**
+     * 有效区域：裁剪区域，未裁剪时为整帧
+     * 检测图只覆盖这一区域，关键点坐标仍以整帧为准
+     */
+    cv::Rect region() const { return crop.empty() ? cv::Rect(0, 0, width(), height()) : crop; }
+};
+
+/**
+ * 有效区域的图像视图（BGR / YUYV，不拷贝）
+ */
+inline cv::Mat frameRegion(const CameraFrame& frame) {
+    return frame.crop.empty() ? frame.image : frame.image(frame.crop);
+}
+
+/**
+ * NV12 帧有效区域的 Y 平面（CV_8UC1）与交错 UV 平面（CV_8UC2，半分辨率）视图，不拷贝
+ */
+inline void frameRegionNV12(const CameraFrame& frame, cv::Mat& y, cv::Mat& uv) {
+    cv::Rect region = frame.region();
+    int height = frame.height();
+    y = cv::Mat(region.height, region.width, CV_8UC1,
+                const_cast<uint8_t*>(frame.image.ptr(region.y)) + region.x, frame.image.step);
+    uv = cv::Mat(region.height / 2, region.width / 2, CV_8UC2,
+                 const_cast<uint8_t*>(frame.image.ptr(height + region.y / 2)) + region.x, frame.image.step);
+}
+
+/**
+ * 获取帧有效区域的 BGR 视图：BGR 帧直接浅拷贝，YUV 帧转换到 scratch（复用其缓冲）
+ * @param frame 输入帧
+ * @param scratch 转换用的缓冲
+ * @return BGR 图像
+ */
+inline cv::Mat frameToBGR(const CameraFrame& frame, cv::Mat& scratch) {
+    switch (frame.format) {
+        case PixelFormat::YUYV:
+            cv::cvtColor(frameRegion(frame), scratch, cv::COLOR_YUV2BGR_YUYV);
+            return scratch;
+        case PixelFormat::NV12: {
+            if (frame.crop.empty()) {
+                cv::cvtColor(frame.image, scratch, cv::COLOR_YUV2BGR_NV12);
+                return scratch;
+            }
+            // 裁剪后两个平面不再相邻，分平面转换
+            cv::Mat y;
+            cv::Mat uv;
+            frameRegionNV12(frame, y, uv);
+            cv::cvtColorTwoPlane(y, uv, scratch, cv::COLOR_YUV2BGR_NV12);
+            return scratch;
+        }
+        default:
+            return frameRegion(frame);
+    }
+}
+
+} // namespace popcorn
@@ -0,0 +1,152 @@
+#include "CaptureGovernor.h"
+#include "FrameSource.h"
+#include <iostream>
+#include <algorithm>
+#include <sstream>
+
+namespace popcorn {
+
+namespace {
+
+// 窗口内的 tick 太少（如调试断点后）时不做决策
+constexpr uint32_t MIN_WINDOW_TICKS = 30;
+
+// 按比例缩放尺寸，取偶数（YUV 格式要求）
+int scaleDimension(int value, int num, int den) {
+    return std::max(2, (value * num / den) & ~1);
+}
+
+} // namespace
+
+std::string CaptureMode::toString() const {
+    std::ostringstream out;
+    out << width << "x" << height << "@" << fps;
+    return out.str();
+}
+
+void CaptureGovernor::initialize(const CaptureMode& maxMode, const Config& config) {
+    m_config = config;
+
+    const int w = maxMode.width;
+    const int h = maxMode.height;
+    const double fps = maxMode.fps;
+    std::vector<CaptureMode> ladder = {
+        {w, h, fps},
+        {scaleDimension(w, 3, 4), scaleDimension(h, 3, 4), fps},
+        {scaleDimension(w, 1, 2), scaleDimension(h, 1, 2), fps},
+        {scaleDimension(w, 1, 2), scaleDimension(h, 1, 2), fps * 2.0 / 3.0},
+        {scaleDimension(w, 1, 2), scaleDimension(h, 1, 2), fps / 2.0},
+    };
+    setLadder(ladder);
+}
+
+void CaptureGovernor::setLadder(const std::vector<CaptureMode>& ladder) {
+    m_ladder = ladder.empty() ? std::vector<CaptureMode>{CaptureMode{}} : ladder;
+    m_level = 0;
+    m_headroomWindows = 0;
+    m_lastDowngradeUs = 0;
+    m_lastUpgradeUs = 0;
+    m_cooldownUs = static_cast<int64_t>(m_config.cooldownSeconds * 1e6f);
+    resetWindow(nowMicros());
+
+    std::cout << "[Governor] Capture ladder:";
+    for (const auto& mode : m_ladder) {
+        std::cout << " " << mode.toString();
+    }
+    std::cout << "\n";
+}
+
+void CaptureGovernor::resetWindow(int64_t now) {
+    m_windowStartUs = now;
+    m_ticks = 0;
+    m_ticksOverBudget = 0;
+    m_ticksNearBudget = 0;
+    m_detections = 0;
+    m_detectionsOverBudget = 0;
+    m_detectionsNearBudget = 0;
+}
+
+bool CaptureGovernor::update(float workMs, float detectionMs, CaptureMode& mode) {
+    ++m_ticks;
+    if (workMs > m_config.frameBudgetMs * m_config.overBudgetRatio) {
+        ++m_ticksOverBudget;
+    }
+    if (workMs > m_config.frameBudgetMs * m_config.headroomRatio) {
+        ++m_ticksNearBudget;
+    }
+
+    if (detectionMs >= 0.0f) {
+        ++m_detections;
+        if (detectionMs > m_config.detectionBudgetMs * m_config.overBudgetRatio) {
+            ++m_detectionsOverBudget;
+        }
+        if (detectionMs > m_config.detectionBudgetMs * m_config.headroomRatio) {
+            ++m_detectionsNearBudget;
+        }
+    }
+
+    int64_t now = nowMicros();
+    if (now - m_windowStartUs < static_cast<int64_t>(m_config.windowSeconds * 1e6f)) {
+        return false;
+    }
+    return evaluate(now, mode);
+}
+
+bool CaptureGovernor::evaluate(int64_t now, CaptureMode& mode) {
+    if (m_ticks < MIN_WINDOW_TICKS) {
+        resetWindow(now);
+        return false;
+    }
+
+    const float limit = m_config.overBudgetFraction;
+    const float frameOver = static_cast<float>(m_ticksOverBudget) / m_ticks;
+    const float frameNear = static_cast<float>(m_ticksNearBudget) / m_ticks;
+    const float detectionOver = m_detections ? static_cast<float>(m_detectionsOverBudget) / m_detections : 0.0f;
+    const float detectionNear = m_detections ? static_cast<float>(m_detectionsNearBudget) / m_detections : 0.0f;
+    resetWindow(now);
+
+    const int lastLevel = getLevelCount() - 1;
+
+    // 超预算：立即降一档
+    if (frameOver > limit || detectionOver > limit) {
+        m_headroomWindows = 0;
+        if (m_level >= lastLevel) {
+            return false;
+        }
+
+        // 刚升档就扛不住：说明上一档确实超出能力，延长冷却期
+        if (m_lastUpgradeUs != 0 && now - m_lastUpgradeUs < m_cooldownUs) {
+            m_cooldownUs = std::min(m_cooldownUs * 2,
+                                    static_cast<int64_t>(m_config.maxCooldownSeconds * 1e6f));
+        }
+
+        ++m_level;
+        m_lastDowngradeUs = now;
+        mode = m_ladder[m_level];
+        std::cout << "[Governor] Over budget (frame " << frameOver * 100.0f << "%, detection "
+                  << detectionOver * 100.0f << "% of samples), stepping down to "
+                  << mode.toString() << "\n";
+        return true;
+    }
+
+    // 有余量：连续若干窗口且已过冷却期才升一档
+    if (frameNear <= limit && detectionNear <= limit) {
+        ++m_headroomWindows;
+    } else {
+        m_headroomWindows = 0;
+    }
+
+    if (m_level == 0 || m_headroomWindows < m_config.upgradeWindows ||
+        now - m_lastDowngradeUs < m_cooldownUs) {
+        return false;
+    }
+
+    m_headroomWindows = 0;
+    --m_level;
+    m_lastUpgradeUs = now;
+    mode = m_ladder[m_level];
+    std::cout << "[Governor] Headroom available, stepping up to " << mode.toString() << "\n";
+    return true;
+}
+
+} // namespace popcorn
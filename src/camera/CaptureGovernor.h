@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace popcorn {
+
+/**
+ * 采集模式（分辨率 + 帧率）
+ */
+struct CaptureMode {
+    int width{0};
+    int height{0};
+    double fps{0.0};
+
+    std::string toString() const;
+};
+
+/**
+ * 采集档位调节器
+ *
+ * 按主循环每个 tick 的工作耗时和检测耗时，在一组从高到低的采集模式之间切换：
+ * 一个评估窗口内超预算的 tick 比例过高就立即降一档；
+ * 连续多个窗口都有充足余量、且距上次降档已过冷却期才升一档。
+ * 升档后很快又被迫降档时冷却期加倍，避免在两档之间来回振荡。
+ *
+ * 检测耗时只计入随采集分辨率变化的部分：检测器平时在采集线程生成的固定尺寸检测图上推理，
+ * 耗时与采集档位无关，降档只会白白损失画质；只有退回全分辨率帧的路径（没有检测图、
+ * 或智能裁剪在全分辨率 BGR 帧上跟踪）的转换与缩放开销才随分辨率增长，降档能够缓解。
+ *
+ * 只做决策，不接触摄像头；由调用方把结果交给 CameraCapture::requestCaptureMode
+ */
+class CaptureGovernor {
+public:
+    /**
+     * 调节参数
+     */
+    struct Config {
+        float frameBudgetMs{1000.0f / 60.0f};   // 主循环 tick 的工作耗时预算
+        float detectionBudgetMs{10.0f};         // 单帧检测耗时预算
+        float overBudgetRatio{1.15f};           // 超过预算该倍数的 tick 计为超预算
+        float headroomRatio{0.7f};              // 低于预算该倍数的 tick 计为有余量
+        float overBudgetFraction{0.1f};         // 窗口内超预算 tick 比例超过该值即降档
+        float windowSeconds{2.0f};              // 评估窗口长度
+        int upgradeWindows{3};                  // 连续有余量的窗口数达到该值才升档
+        float cooldownSeconds{10.0f};           // 降档后的最短升档间隔（初始值）
+        float maxCooldownSeconds{120.0f};       // 冷却期加倍的上限
+    };
+
+    CaptureGovernor() = default;
+
+    /**
+     * 以最高档初始化，按默认比例生成档位：
+     * 原始 -> 3/4 分辨率 -> 1/2 分辨率 -> 1/2 分辨率 2/3 帧率 -> 1/2 分辨率 1/2 帧率
+     * @param maxMode 最高档（通常为摄像头初始协商到的模式）
+     * @param config 调节参数
+     */
+    void initialize(const CaptureMode& maxMode, const Config& config);
+    void initialize(const CaptureMode& maxMode) { initialize(maxMode, Config{}); }
+
+    /**
+     * 使用自定义档位（从高到低），从第 0 档开始
+     */
+    void setLadder(const std::vector<CaptureMode>& ladder);
+
+    /**
+     * 记录一个主循环 tick，并在评估窗口结束时做出决策
+     * @param workMs 本 tick 的工作耗时（不含帧率限制的休眠）
+     * @param detectionMs 本 tick 在全分辨率帧上检测的耗时；未运行检测、或只在固定尺寸的检测图上检测时传负值
+     * @param mode 需要切换时输出新的采集模式
+     * @return 需要切换档位时返回 true
+     */
+    bool update(float workMs, float detectionMs, CaptureMode& mode);
+
+    /**
+     * 当前档位（0 为最高档）与对应模式
+     */
+    int getLevel() const { return m_level; }
+    const CaptureMode& getMode() const { return m_ladder[m_level]; }
+
+    /**
+     * 档位数
+     */
+    int getLevelCount() const { return static_cast<int>(m_ladder.size()); }
+
+private:
+    // 结束当前窗口并决定是否切换档位
+    bool evaluate(int64_t now, CaptureMode& mode);
+
+    void resetWindow(int64_t now);
+
+private:
+    Config m_config;
+    std::vector<CaptureMode> m_ladder{CaptureMode{}};
+    int m_level{0};
+
+    // 当前评估窗口
+    int64_t m_windowStartUs{0};
+    uint32_t m_ticks{0};
+    uint32_t m_ticksOverBudget{0};
+    uint32_t m_ticksNearBudget{0};          // 未达到有余量标准的 tick
+    uint32_t m_detections{0};
+    uint32_t m_detectionsOverBudget{0};
+    uint32_t m_detectionsNearBudget{0};
+
+    int m_headroomWindows{0};               // 连续有余量的窗口数
+    int64_t m_lastDowngradeUs{0};
+    int64_t m_lastUpgradeUs{0};
+    int64_t m_cooldownUs{0};
+};
+
+} // namespace popcorn
@@ -0,0 +1,184 @@
+#include "CaptureStats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace popcorn {
+
+namespace {
+
+int highestBit(uint64_t value) {
+    int bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+}
+
+} // namespace
+
+// ============================================================
+// LatencyHistogram
+// ============================================================
+
+int LatencyHistogram::bucketIndex(uint64_t us) {
+    if (us < SUB_BUCKETS) {
+        return static_cast<int>(us);
+    }
+
+    // [2^msb, 2^(msb+1)) 均分为 4 个子桶，由最高位之后的两位决定
+    int msb = highestBit(us);
+    int sub = static_cast<int>((us >> (msb - 2)) & (SUB_BUCKETS - 1));
+    int index = (msb - 1) * SUB_BUCKETS + sub;
+    return std::min(index, BUCKET_COUNT - 1);
+}
+
+int64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return index + 1;
+    }
+    int msb = index / SUB_BUCKETS + 1;
+    int sub = index % SUB_BUCKETS;
+    return static_cast<int64_t>(SUB_BUCKETS + 1 + sub) << (msb - 2);
+}
+
+void LatencyHistogram::record(int64_t us) {
+    us = std::max<int64_t>(us, 0);
+    m_buckets[bucketIndex(static_cast<uint64_t>(us))].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sumUs.fetch_add(us, std::memory_order_relaxed);
+
+    // 单写者，无需 CAS 循环
+    if (us > m_maxUs.load(std::memory_order_relaxed)) {
+        m_maxUs.store(us, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sumUs.store(0, std::memory_order_relaxed);
+    m_maxUs.store(0, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snap;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        snap.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    snap.count = m_count.load(std::memory_order_relaxed);
+    snap.sumUs = m_sumUs.load(std::memory_order_relaxed);
+    snap.maxUs = m_maxUs.load(std::memory_order_relaxed);
+    return snap;
+}
+
+int64_t LatencyHistogram::Snapshot::percentileUs(double percentile) const {
+    uint64_t total = 0;
+    for (uint64_t bucket : buckets) {
+        total += bucket;
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(total * std::clamp(percentile, 0.0, 100.0) / 100.0));
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen >= target) {
+            int64_t upper = bucketUpperBound(i);
+            return maxUs > 0 ? std::min(upper, maxUs) : upper;
+        }
+    }
+    return maxUs;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::Snapshot::since(const Snapshot& earlier) const {
+    Snapshot delta;
+    delta.count = count - earlier.count;
+    delta.sumUs = sumUs - earlier.sumUs;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        delta.buckets[i] = buckets[i] - earlier.buckets[i];
+        if (delta.buckets[i] != 0) {
+            delta.maxUs = bucketUpperBound(i);
+        }
+    }
+    // 区间最大值不会超过累计最大值
+    delta.maxUs = std::min(delta.maxUs, maxUs);
+    return delta;
+}
+
+// ============================================================
+// CaptureStats
+// ============================================================
+
+void CaptureStats::reset(double nominalFps) {
+    m_readBlock.reset();
+    m_interval.reset();
+    m_jitter.reset();
+    m_framesCaptured.store(0, std::memory_order_relaxed);
+    m_failedReads.store(0, std::memory_order_relaxed);
+    m_failureStreak.store(0, std::memory_order_relaxed);
+    m_longestFailureStreak.store(0, std::memory_order_relaxed);
+
+    setNominalFps(nominalFps);
+}
+
+void CaptureStats::setNominalFps(double nominalFps) {
+    m_nominalIntervalUs = nominalFps > 0.0 ? static_cast<int64_t>(1000000.0 / nominalFps) : 0;
+    m_lastTimestampUs = 0;
+}
+
+void CaptureStats::recordRead(int64_t blockedUs, bool ok, int64_t timestampUs) {
+    m_readBlock.record(blockedUs);
+
+    if (!ok) {
+        m_failedReads.fetch_add(1, std::memory_order_relaxed);
+        uint64_t streak = m_failureStreak.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (streak > m_longestFailureStreak.load(std::memory_order_relaxed)) {
+            m_longestFailureStreak.store(streak, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    m_framesCaptured.fetch_add(1, std::memory_order_relaxed);
+    m_failureStreak.store(0, std::memory_order_relaxed);
+
+    if (m_lastTimestampUs != 0 && timestampUs > m_lastTimestampUs) {
+        int64_t interval = timestampUs - m_lastTimestampUs;
+        m_interval.record(interval);
+        if (m_nominalIntervalUs > 0) {
+            m_jitter.record(std::abs(interval - m_nominalIntervalUs));
+        }
+    }
+    m_lastTimestampUs = timestampUs;
+}
+
+CaptureStats::Snapshot CaptureStats::snapshot() const {
+    Snapshot snap;
+    snap.framesCaptured = m_framesCaptured.load(std::memory_order_relaxed);
+    snap.failedReads = m_failedReads.load(std::memory_order_relaxed);
+    snap.longestFailureStreak = m_longestFailureStreak.load(std::memory_order_relaxed);
+    snap.readBlockUs = m_readBlock.snapshot();
+    snap.intervalUs = m_interval.snapshot();
+    snap.jitterUs = m_jitter.snapshot();
+    return snap;
+}
+
+CaptureStats::Snapshot CaptureStats::Snapshot::since(const Snapshot& earlier) const {
+    Snapshot delta;
+    delta.framesCaptured = framesCaptured - earlier.framesCaptured;
+    delta.failedReads = failedReads - earlier.failedReads;
+    delta.longestFailureStreak = longestFailureStreak;
+    delta.droppedUnconsumed = droppedUnconsumed - earlier.droppedUnconsumed;
+    delta.droppedPoolFull = droppedPoolFull - earlier.droppedPoolFull;
+    delta.readBlockUs = readBlockUs.since(earlier.readBlockUs);
+    delta.intervalUs = intervalUs.since(earlier.intervalUs);
+    delta.jitterUs = jitterUs.since(earlier.jitterUs);
+    return delta;
+}
+
+} // namespace popcorn
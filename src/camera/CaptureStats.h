@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace popcorn {
+
+/**
+ * 无锁延迟直方图（微秒）
+ *
+ * 对数-线性分桶：每个 2 的幂区间再均分为 4 个子桶，相对误差不超过 25%，
+ * 覆盖 0 ~ 约 67 秒。单写者（采集线程）记录，任意线程读取快照。
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKETS = 4;
+    static constexpr int BUCKET_COUNT = 100;
+
+    /**
+     * 直方图快照
+     */
+    struct Snapshot {
+        uint64_t count{0};
+        int64_t sumUs{0};
+        int64_t maxUs{0};           // 累计最大值（since() 得到的区间快照中为区间内最高非空桶的上界）
+        std::array<uint64_t, BUCKET_COUNT> buckets{};
+
+        double meanUs() const { return count ? static_cast<double>(sumUs) / count : 0.0; }
+
+        /**
+         * 百分位数（返回所在桶的上界）
+         * @param percentile 0 ~ 100
+         */
+        int64_t percentileUs(double percentile) const;
+
+        /**
+         * 与更早的快照相减，得到两次快照之间的区间统计
+         */
+        Snapshot since(const Snapshot& earlier) const;
+    };
+
+    /**
+     * 记录一个样本（负值按 0 记录）
+     */
+    void record(int64_t us);
+
+    /**
+     * 清零（不得与 record 并发）
+     */
+    void reset();
+
+    Snapshot snapshot() const;
+
+    /**
+     * 桶的上界（微秒，不含）
+     */
+    static int64_t bucketUpperBound(int index);
+
+private:
+    static int bucketIndex(uint64_t us);
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<int64_t> m_sumUs{0};
+    std::atomic<int64_t> m_maxUs{0};
+};
+
+/**
+ * 采集流水线统计
+ * 由采集线程更新，用于把摄像头的卡顿与主循环的帧时间尖峰对应起来
+ */
+class CaptureStats {
+public:
+    /**
+     * 统计快照
+     */
+    struct Snapshot {
+        uint64_t framesCaptured{0};     // 成功读取并发布的帧数
+        uint64_t failedReads{0};        // read() 失败次数
+        uint64_t longestFailureStreak{0}; // 最长连续失败次数
+        uint64_t droppedUnconsumed{0};  // 发布后未被任何消费者取走就被覆盖的帧（消费者太慢）
+        uint64_t droppedPoolFull{0};    // 帧池无空闲槽位而丢弃的帧
+
+        LatencyHistogram::Snapshot readBlockUs;     // 阻塞在 read() 中的时间
+        LatencyHistogram::Snapshot intervalUs;      // 相邻两帧采集时间戳的间隔
+        LatencyHistogram::Snapshot jitterUs;        // 帧间隔与标称间隔之差的绝对值
+
+        /**
+         * 与更早的快照相减，得到区间统计
+         */
+        Snapshot since(const Snapshot& earlier) const;
+    };
+
+    /**
+     * 重新开始统计（采集线程启动时调用）
+     * @param nominalFps 帧源标称帧率，用于计算抖动
+     */
+    void reset(double nominalFps);
+
+    /**
+     * 采集模式切换后更新标称帧率（采集线程），不清零累计值；
+     * 切换期间的停顿不计入帧间隔
+     */
+    void setNominalFps(double nominalFps);
+
+    /**
+     * 记录一次 read() 调用（采集线程）
+     * @param blockedUs read() 耗时
+     * @param ok 是否成功
+     * @param timestampUs 成功时帧的采集时间戳
+     */
+    void recordRead(int64_t blockedUs, bool ok, int64_t timestampUs);
+
+    Snapshot snapshot() const;
+
+    /**
+     * 当前连续失败次数
+     */
+    uint64_t getFailureStreak() const { return m_failureStreak.load(std::memory_order_relaxed); }
+
+private:
+    LatencyHistogram m_readBlock;
+    LatencyHistogram m_interval;
+    LatencyHistogram m_jitter;
+
+    std::atomic<uint64_t> m_framesCaptured{0};
+    std::atomic<uint64_t> m_failedReads{0};
+    std::atomic<uint64_t> m_failureStreak{0};
+    std::atomic<uint64_t> m_longestFailureStreak{0};
+
+    int64_t m_nominalIntervalUs{0};     // 仅采集线程访问
+    int64_t m_lastTimestampUs{0};
+};
+
+} // namespace popcorn
@@ -0,0 +1,93 @@
+#include "DeviceFrameSource.h"
+#include <iostream>
+
+namespace popcorn {
+
+DeviceFrameSource::DeviceFrameSource(int deviceId, int width, int height, double fps)
+    : m_deviceId(deviceId)
+    , m_requestedWidth(width)
+    , m_requestedHeight(height)
+    , m_requestedFps(fps) {}
+
+DeviceFrameSource::~DeviceFrameSource() {
+    close();
+}
+
+bool DeviceFrameSource::open() {
+    std::cout << "[Camera] Opening device " << m_deviceId << "...\n";
+
+    // 打开摄像头
+    m_capture.open(m_deviceId);
+
+    if (!m_capture.isOpened()) {
+        std::cerr << "[Camera] Failed to open camera " << m_deviceId << "\n";
+        return false;
+    }
+
+    // 设置分辨率
+    m_capture.set(cv::CAP_PROP_FRAME_WIDTH, m_requestedWidth);
+    m_capture.set(cv::CAP_PROP_FRAME_HEIGHT, m_requestedHeight);
+    m_capture.set(cv::CAP_PROP_FPS, m_requestedFps);
+
+    // 获取实际分辨率
+    m_width = static_cast<int>(m_capture.get(cv::CAP_PROP_FRAME_WIDTH));
+    m_height = static_cast<int>(m_capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+    m_fps = m_capture.get(cv::CAP_PROP_FPS);
+    if (m_fps <= 0.0) {
+        m_fps = m_requestedFps;
+    }
+
+    std::cout << "[Camera] Opened at " << m_width << "x" << m_height << "\n";
+    return true;
+}
+
+void DeviceFrameSource::close() {
+    if (m_capture.isOpened()) {
+        m_capture.release();
+    }
+}
+
+bool DeviceFrameSource::read(CameraFrame& frame) {
+    // 直接读入目标缓冲，尺寸不变时 OpenCV 复用已有内存
+    if (!m_capture.read(frame.image)) {
+        return false;
+    }
+    frame.format = PixelFormat::BGR;
+    frame.timestampUs = nowMicros();
+    return true;
+}
+
+bool DeviceFrameSource::reconfigure(int width, int height, double fps) {
+    if (!m_capture.isOpened()) {
+        return false;
+    }
+
+    m_requestedWidth = width;
+    m_requestedHeight = height;
+    m_requestedFps = fps;
+
+    // 多数后端（V4L2、MSMF、AVFoundation）允许在打开状态下直接修改，内部会重启流
+    m_capture.set(cv::CAP_PROP_FRAME_WIDTH, width);
+    m_capture.set(cv::CAP_PROP_FRAME_HEIGHT, height);
+    m_capture.set(cv::CAP_PROP_FPS, fps);
+
+    m_width = static_cast<int>(m_capture.get(cv::CAP_PROP_FRAME_WIDTH));
+    m_height = static_cast<int>(m_capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+    m_fps = m_capture.get(cv::CAP_PROP_FPS);
+    if (m_fps <= 0.0) {
+        m_fps = fps;
+    }
+
+    std::cout << "[Camera] Reconfigured to " << m_width << "x" << m_height << " @ " << m_fps << "fps\n";
+    return true;
+}
+
+bool DeviceFrameSource::skip() {
+    return m_capture.grab();
+}
+
+std::string DeviceFrameSource::getName() const {
+    return "camera:" + std::to_string(m_deviceId);
+}
+
+} // namespace popcorn
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include "FrameSource.h"
+
+namespace popcorn {
+
+/**
+ * 实时摄像头帧源
+ * 使用 OpenCV VideoCapture 进行跨平台摄像头采集
+ */
+class DeviceFrameSource : public FrameSource {
+public:
+    /**
+     * @param deviceId 设备 ID（通常为 0）
+     * @param width 期望宽度
+     * @param height 期望高度
+     * @param fps 期望帧率
+     */
+    DeviceFrameSource(int deviceId, int width, int height, double fps);
+    ~DeviceFrameSource() override;
+
+    bool open() override;
+    void close() override;
+    bool read(CameraFrame& frame) override;
+    bool skip() override;
+    bool isLive() const override { return true; }
+    bool supportsReconfigure() const override { return true; }
+    bool reconfigure(int width, int height, double fps) override;
+
+    int getWidth() const override { return m_width; }
+    int getHeight() const override { return m_height; }
+    double getFps() const override { return m_fps; }
+    std::string getName() const override;
+
+private:
+    cv::VideoCapture m_capture;
+
+    int m_deviceId{0};
+    int m_requestedWidth{0};
+    int m_requestedHeight{0};
+    double m_requestedFps{30.0};
+
+    int m_width{0};
+    int m_height{0};
+    double m_fps{0.0};
+};
+
+} // namespace popcorn
@@ -0,0 +1,236 @@
+#include "FileFrameSource.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace popcorn {
+
+// ============= FramePacer =============
+
+void FramePacer::reset() {
+    m_start = std::chrono::steady_clock::now();
+    m_started = true;
+}
+
+void FramePacer::wait(uint64_t frameIndex, double nativeFps) {
+    if (m_mode == PacingMode::AsFastAsPossible) {
+        return;
+    }
+    if (!m_started) {
+        reset();
+    }
+
+    double fps = (m_mode == PacingMode::FixedRate) ? m_fixedFps : nativeFps;
+    if (fps <= 0.0) {
+        return;
+    }
+
+    auto target = m_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(static_cast<double>(frameIndex) / fps));
+    std::this_thread::sleep_until(target);
+}
+
+void FramePacer::waitOffset(int64_t offsetUs) {
+    if (m_mode == PacingMode::AsFastAsPossible) {
+        return;
+    }
+    if (!m_started) {
+        reset();
+    }
+    if (offsetUs > 0) {
+        std::this_thread::sleep_until(m_start + std::chrono::microseconds(offsetUs));
+    }
+}
+
+// ============= VideoFileSource =============
+
+VideoFileSource::VideoFileSource(const std::string& path, PacingMode pacing, double fixedFps, bool loop)
+    : m_path(path)
+    , m_pacer(pacing, fixedFps)
+    , m_loop(loop) {}
+
+VideoFileSource::~VideoFileSource() {
+    close();
+}
+
+bool VideoFileSource::open() {
+    std::cout << "[VideoFileSource] Opening " << m_path << "...\n";
+
+    m_capture.open(m_path);
+    if (!m_capture.isOpened()) {
+        std::cerr << "[VideoFileSource] Failed to open " << m_path << "\n";
+        return false;
+    }
+
+    m_width = static_cast<int>(m_capture.get(cv::CAP_PROP_FRAME_WIDTH));
+    m_height = static_cast<int>(m_capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+    m_fps = m_capture.get(cv::CAP_PROP_FPS);
+    if (m_fps <= 0.0) {
+        m_fps = 30.0;
+    }
+
+    m_frameIndex = 0;
+    m_finished = false;
+
+    std::cout << "[VideoFileSource] Opened " << m_width << "x" << m_height
+              << " @ " << m_fps << "fps\n";
+    return true;
+}
+
+void VideoFileSource::close() {
+    if (m_capture.isOpened()) {
+        m_capture.release();
+    }
+}
+
+bool VideoFileSource::read(CameraFrame& frame) {
+    if (m_finished) {
+        return false;
+    }
+
+    if (!m_capture.read(frame.image)) {
+        if (!m_loop) {
+            std::cout << "[VideoFileSource] End of file\n";
+            m_finished = true;
+            return false;
+        }
+
+        // 回到开头重新播放
+        m_capture.set(cv::CAP_PROP_POS_FRAMES, 0);
+        m_frameIndex = 0;
+        m_pacer.reset();
+        if (!m_capture.read(frame.image)) {
+            m_finished = true;
+            return false;
+        }
+    }
+
+    m_pacer.wait(m_frameIndex++, m_fps);
+    frame.format = PixelFormat::BGR;
+    frame.timestampUs = nowMicros();
+    return true;
+}
+
+// ============= ImageSequenceSource =============
+
+ImageSequenceSource::ImageSequenceSource(const std::string& directory, PacingMode pacing,
+                                         double fps, bool loop)
+    : m_directory(directory)
+    , m_pacer(pacing, fps)
+    , m_loop(loop)
+    , m_fps(fps > 0.0 ? fps : 30.0) {}
+
+ImageSequenceSource::~ImageSequenceSource() {
+    close();
+}
+
+bool ImageSequenceSource::open() {
+    namespace fs = std::filesystem;
+
+    std::cout << "[ImageSequenceSource] Scanning " << m_directory << "...\n";
+
+    std::error_code ec;
+    if (!fs::is_directory(m_directory, ec)) {
+        std::cerr << "[ImageSequenceSource] Not a directory: " << m_directory << "\n";
+        return false;
+    }
+
+    m_files.clear();
+    for (const auto& entry : fs::directory_iterator(m_directory, ec)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        std::string ext = entry.path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (ext == ".png" || ext == ".jpg" || ext == ".jpeg") {
+            m_files.push_back(entry.path().string());
+        }
+    }
+    std::sort(m_files.begin(), m_files.end());
+
+    if (m_files.empty()) {
+        std::cerr << "[ImageSequenceSource] No PNG/JPEG files in " << m_directory << "\n";
+        return false;
+    }
+
+    // 以第一张图片确定帧尺寸
+    cv::Mat first;
+    if (!decodeFile(m_files.front(), first)) {
+        std::cerr << "[ImageSequenceSource] Failed to decode " << m_files.front() << "\n";
+        return false;
+    }
+    m_width = first.cols;
+    m_height = first.rows;
+
+    m_index = 0;
+    m_frameIndex = 0;
+    m_finished = false;
+
+    std::cout << "[ImageSequenceSource] " << m_files.size() << " images, "
+              << m_width << "x" << m_height << " @ " << m_fps << "fps\n";
+    return true;
+}
+
+void ImageSequenceSource::close() {
+    m_files.clear();
+    m_fileBuffer.clear();
+    m_fileBuffer.shrink_to_fit();
+}
+
+bool ImageSequenceSource::read(CameraFrame& frame) {
+    if (m_finished || m_files.empty()) {
+        return false;
+    }
+
+    if (m_index >= m_files.size()) {
+        if (!m_loop) {
+            std::cout << "[ImageSequenceSource] End of sequence\n";
+            m_finished = true;
+            return false;
+        }
+        m_index = 0;
+        m_frameIndex = 0;
+        m_pacer.reset();
+    }
+
+    const std::string& path = m_files[m_index++];
+    if (!decodeFile(path, frame.image)) {
+        std::cerr << "[ImageSequenceSource] Failed to decode " << path << "\n";
+        return false;
+    }
+
+    m_pacer.wait(m_frameIndex++, m_fps);
+    frame.format = PixelFormat::BGR;
+    frame.timestampUs = nowMicros();
+    return true;
+}
+
+bool ImageSequenceSource::decodeFile(const std::string& path, cv::Mat& image) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    if (size <= 0) {
+        return false;
+    }
+    file.seekg(0, std::ios::beg);
+
+    // 文件缓冲只增不减，稳态下不再分配
+    m_fileBuffer.resize(static_cast<size_t>(size));
+    if (!file.read(reinterpret_cast<char*>(m_fileBuffer.data()), size)) {
+        return false;
+    }
+
+    // 解码到调用方提供的缓冲（尺寸相同时复用）
+    cv::imdecode(cv::Mat(1, static_cast<int>(size), CV_8UC1, m_fileBuffer.data()),
+                 cv::IMREAD_COLOR, &image);
+    return !image.empty();
+}
+
+} // namespace popcorn
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "FrameSource.h"
+
+namespace popcorn {
+
+/**
+ * 回放节奏控制器
+ * 以第一帧为起点，把每帧的呈现时刻对齐到墙钟（不累积睡眠误差）
+ */
+class FramePacer {
+public:
+    FramePacer(PacingMode mode, double fixedFps) : m_mode(mode), m_fixedFps(fixedFps) {}
+
+    /**
+     * 重新以当前时刻为起点（首帧或循环回放时调用）
+     */
+    void reset();
+
+    /**
+     * 等待到第 frameIndex 帧的呈现时刻
+     * @param frameIndex 自起点以来的帧序号
+     * @param nativeFps 素材原始帧率（RealTime 模式使用）
+     */
+    void wait(uint64_t frameIndex, double nativeFps);
+
+    /**
+     * 等待到起点之后 offsetUs 微秒（按录制时间戳回放；AsFastAsPossible 模式不等待）
+     */
+    void waitOffset(int64_t offsetUs);
+
+private:
+    PacingMode m_mode;
+    double m_fixedFps;
+    bool m_started{false};
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * 视频文件帧源
+ */
+class VideoFileSource : public FrameSource {
+public:
+    VideoFileSource(const std::string& path, PacingMode pacing, double fixedFps, bool loop);
+    ~VideoFileSource() override;
+
+    bool open() override;
+    void close() override;
+    bool read(CameraFrame& frame) override;
+    bool isFinished() const override { return m_finished; }
+
+    int getWidth() const override { return m_width; }
+    int getHeight() const override { return m_height; }
+    double getFps() const override { return m_fps; }
+    std::string getName() const override { return "video:" + m_path; }
+
+private:
+    cv::VideoCapture m_capture;
+    std::string m_path;
+    FramePacer m_pacer;
+    bool m_loop{true};
+    bool m_finished{false};
+
+    uint64_t m_frameIndex{0};   // 自本轮播放开始以来的帧数
+
+    int m_width{0};
+    int m_height{0};
+    double m_fps{30.0};
+};
+
+/**
+ * 图片序列帧源（目录下按文件名排序的 PNG/JPEG）
+ */
+class ImageSequenceSource : public FrameSource {
+public:
+    ImageSequenceSource(const std::string& directory, PacingMode pacing, double fps, bool loop);
+    ~ImageSequenceSource() override;
+
+    bool open() override;
+    void close() override;
+    bool read(CameraFrame& frame) override;
+    bool isFinished() const override { return m_finished; }
+
+    int getWidth() const override { return m_width; }
+    int getHeight() const override { return m_height; }
+    double getFps() const override { return m_fps; }
+    std::string getName() const override { return "images:" + m_directory; }
+
+private:
+    // 读入并解码一张图片（复用文件缓冲和输出缓冲）
+    bool decodeFile(const std::string& path, cv::Mat& image);
+
+private:
+    std::string m_directory;
+    std::vector<std::string> m_files;
+    std::vector<uint8_t> m_fileBuffer;
+    FramePacer m_pacer;
+    bool m_loop{true};
+    bool m_finished{false};
+
+    size_t m_index{0};          // 下一张图片
+    uint64_t m_frameIndex{0};   // 自本轮播放开始以来的帧数
+
+    int m_width{0};
+    int m_height{0};
+    double m_fps{30.0};
+};
+
+} // namespace popcorn
@@ -0,0 +1,127 @@
+#include "FrameNotifier.h"
+#include <chrono>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace popcorn {
+
+FrameNotifier::~FrameNotifier() {
+#ifdef __linux__
+    int fd = m_eventFd.exchange(-1);
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#endif
+}
+
+void FrameNotifier::notify(uint64_t sequence) {
+    // 先写序号再读等待者计数（都是 seq_cst）：要么等待者看到新序号，要么这里看到等待者
+    m_sequence.store(sequence);
+    if (m_waiters.load() > 0) {
+        // 加锁保证等待者已进入 wait，通知不会丢失
+        { std::lock_guard<std::mutex> lock(m_mutex); }
+        m_cv.notify_all();
+    }
+
+#ifdef __linux__
+    int fd = m_eventFd.load(std::memory_order_acquire);
+    if (fd >= 0) {
+        uint64_t one = 1;
+        ssize_t written = ::write(fd, &one, sizeof(one));
+        (void)written;  // 计数溢出前消费者早已读取，EAGAIN 可以忽略
+    }
+#endif
+}
+
+void FrameNotifier::interrupt() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interrupted = true;
+    }
+    m_cv.notify_all();
+
+#ifdef __linux__
+    // 让 poll 中的消费者也醒来检查采集状态
+    int fd = m_eventFd.load(std::memory_order_acquire);
+    if (fd >= 0) {
+        uint64_t one = 1;
+        ssize_t written = ::write(fd, &one, sizeof(one));
+        (void)written;
+    }
+#endif
+}
+
+void FrameNotifier::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_interrupted = false;
+    m_sequence = 0;
+}
+
+bool FrameNotifier::wait(uint64_t lastSequence, int64_t timeoutUs) {
+    if (m_sequence.load(std::memory_order_acquire) > lastSequence) {
+        return true;
+    }
+    if (timeoutUs == 0) {
+        return false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutUs);
+    auto ready = [&] { return m_sequence.load() > lastSequence || m_interrupted.load(); };
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_waiters.fetch_add(1);
+    if (timeoutUs < 0) {
+        m_cv.wait(lock, ready);
+    } else {
+        m_cv.wait_until(lock, deadline, ready);
+    }
+    m_waiters.fetch_sub(1);
+
+    return m_sequence.load(std::memory_order_acquire) > lastSequence;
+}
+
+bool FrameNotifier::sleep(int64_t durationUs) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_cv.wait_for(lock, std::chrono::microseconds(durationUs),
+                         [&] { return m_interrupted.load(); });
+}
+
+int FrameNotifier::getEventFd() {
+#ifdef __linux__
+    int fd = m_eventFd.load(std::memory_order_acquire);
+    if (fd >= 0) {
+        return fd;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    fd = m_eventFd.load(std::memory_order_acquire);
+    if (fd < 0) {
+        fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd < 0) {
+            std::cerr << "[Camera] Failed to create frame eventfd\n";
+            return -1;
+        }
+        m_eventFd.store(fd, std::memory_order_release);
+    }
+    return fd;
+#else
+    return -1;
+#endif
+}
+
+void FrameNotifier::clearEvent() {
+#ifdef __linux__
+    int fd = m_eventFd.load(std::memory_order_acquire);
+    if (fd >= 0) {
+        uint64_t count = 0;
+        ssize_t bytes = ::read(fd, &count, sizeof(count));
+        (void)bytes;    // 非阻塞：没有累计通知时返回 EAGAIN
+    }
+#endif
+}
+
+} // namespace popcorn
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace popcorn {
+
+/**
+ * 新帧通知
+ *
+ * 采集线程每发布一帧调用 notify()，消费者可以：
+ * - 用 wait() 阻塞到出现比已处理序号更新的帧（带超时）；
+ * - 用 getEventFd() 取得 eventfd（仅 Linux），与其他 fd 一起 poll / epoll。
+ *
+ * 没有等待者、也没有申请 eventfd 时 notify() 只是一次原子写，不加锁、不做系统调用。
+ */
+class FrameNotifier {
+public:
+    FrameNotifier() = default;
+    ~FrameNotifier();
+
+    // 禁止拷贝
+    FrameNotifier(const FrameNotifier&) = delete;
+    FrameNotifier& operator=(const FrameNotifier&) = delete;
+
+    /**
+     * 发布了序号为 sequence 的帧（采集线程）
+     */
+    void notify(uint64_t sequence);
+
+    /**
+     * 唤醒所有等待者并使之后的 wait() 立即返回（停止采集或帧源播放完毕时）
+     */
+    void interrupt();
+
+    /**
+     * 清除中断状态、序号归零（重新开始采集前调用）
+     */
+    void reset();
+
+    /**
+     * 等待比 lastSequence 更新的帧
+     * @param lastSequence 调用方已处理过的最新帧序号
+     * @param timeoutUs 超时（微秒），负数表示一直等待
+     * @return 有新帧返回 true；超时或被中断返回 false
+     */
+    bool wait(uint64_t lastSequence, int64_t timeoutUs);
+
+    /**
+     * 可中断的休眠（采集线程的重试退避）
+     * @return 被中断返回 true
+     */
+    bool sleep(int64_t durationUs);
+
+    /**
+     * 最近一次通知的帧序号
+     */
+    uint64_t getSequence() const { return m_sequence.load(std::memory_order_acquire); }
+
+    /**
+     * 新帧 eventfd（首次调用时创建，非阻塞；仅 Linux，其他平台返回 -1）
+     * 每发布一帧计数加一，可读即表示有新帧；读出后用 clearEvent() 清零
+     */
+    int getEventFd();
+
+    /**
+     * 清除 eventfd 上累计的通知
+     */
+    void clearEvent();
+
+private:
+    std::atomic<uint64_t> m_sequence{0};
+    std::atomic<bool> m_interrupted{false};
+    std::atomic<int> m_waiters{0};
+    std::atomic<int> m_eventFd{-1};
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+} // namespace popcorn
@@ -0,0 +1,331 @@
+#include "FramePool.h"
+#include <iostream>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace popcorn {
+
+namespace {
+
+constexpr uint32_t WRITER_BIT = 0x80000000u;
+
+#ifdef __linux__
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+#endif
+
+} // namespace
+
+// ============= FrameHandle =============
+
+FrameHandle::FrameHandle(const FrameHandle& other) : m_slot(other.m_slot) {
+    if (m_slot) {
+        m_slot->refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+FrameHandle& FrameHandle::operator=(const FrameHandle& other) {
+    if (this != &other) {
+        if (other.m_slot) {
+            other.m_slot->refCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        reset();
+        m_slot = other.m_slot;
+    }
+    return *this;
+}
+
+FrameHandle& FrameHandle::operator=(FrameHandle&& other) noexcept {
+    if (this != &other) {
+        reset();
+        m_slot = other.m_slot;
+        other.m_slot = nullptr;
+    }
+    return *this;
+}
+
+void FrameHandle::reset() {
+    if (m_slot) {
+        FramePool::releaseRef(m_slot);
+        m_slot = nullptr;
+    }
+}
+
+// ============= FramePool =============
+
+FramePool::~FramePool() {
+    release();
+}
+
+bool FramePool::initialize(size_t slotCount, int width, int height, int type, bool useHugePages) {
+    release();
+
+    if (slotCount < 3 || width <= 0 || height <= 0) {
+        std::cerr << "[FramePool] Invalid pool configuration\n";
+        return false;
+    }
+
+    m_slots = std::make_unique<FrameSlot[]>(slotCount);
+    m_slotCount = slotCount;
+    m_nextSlot = 0;
+    m_hugePages = useHugePages;
+    m_useHugePages = useHugePages;
+    m_width = width;
+    m_height = height;
+    m_type = type;
+
+    for (size_t i = 0; i < slotCount; ++i) {
+        if (!allocateSlot(m_slots[i], width, height, type, useHugePages)) {
+            std::cerr << "[FramePool] Failed to allocate slot " << i << "\n";
+            release();
+            return false;
+        }
+        m_hugePages = m_hugePages && m_slots[i].mapped;
+    }
+
+    std::cout << "[FramePool] Preallocated " << slotCount << " slots of "
+              << width << "x" << height
+              << (m_hugePages ? " (huge pages)" : "") << "\n";
+    return true;
+}
+
+void FramePool::release() {
+    if (!m_slots) {
+        return;
+    }
+
+    if (FrameSlot* latest = m_latest.exchange(nullptr)) {
+        releaseRef(latest);
+    }
+
+    for (size_t i = 0; i < m_slotCount; ++i) {
+        if (m_slots[i].refCount.load(std::memory_order_acquire) != 0) {
+            std::cerr << "[FramePool] Warning: slot " << i << " still borrowed at release\n";
+        }
+        freeSlot(m_slots[i]);
+    }
+
+    m_slots.reset();
+    m_slotCount = 0;
+    m_latestSequence.store(0, std::memory_order_release);
+}
+
+bool FramePool::allocateSlot(FrameSlot& slot, int width, int height, int type, bool useHugePages) {
+    size_t rowBytes = static_cast<size_t>(width) * CV_ELEM_SIZE(type);
+    size_t bytes = rowBytes * height;
+    uint8_t* memory = nullptr;
+
+#ifdef __linux__
+    if (useHugePages) {
+        size_t mappedBytes = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+        // 优先使用显式大页（需预留 hugetlbfs），失败时退回透明大页
+        void* p = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p == MAP_FAILED) {
+            p = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, mappedBytes, MADV_HUGEPAGE);
+            }
+        }
+
+        if (p != MAP_FAILED) {
+            memory = static_cast<uint8_t*>(p);
+            slot.ownedBytes = mappedBytes;
+            slot.mapped = true;
+        }
+    }
+#else
+    (void)useHugePages;
+#endif
+
+    if (!memory) {
+        memory = static_cast<uint8_t*>(cv::fastMalloc(bytes));
+        slot.ownedBytes = bytes;
+        slot.mapped = false;
+    }
+
+    if (!memory) {
+        return false;
+    }
+
+    // 预先触碰所有页面，避免采集时缺页
+    std::memset(memory, 0, bytes);
+
+    slot.ownedBuffer = memory;
+    slot.buffer = memory;
+    slot.pooledImage = cv::Mat(height, width, type, memory, rowBytes);
+    slot.frame = CameraFrame{};
+    slot.frame.image = slot.pooledImage;
+    slot.refCount.store(0, std::memory_order_relaxed);
+
+    m_allocations.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void FramePool::freeSlot(FrameSlot& slot) {
+    slot.frame = CameraFrame{};
+    slot.pooledImage.release();
+
+    if (slot.ownedBuffer) {
+#ifdef __linux__
+        if (slot.mapped) {
+            munmap(slot.ownedBuffer, slot.ownedBytes);
+        } else {
+            cv::fastFree(slot.ownedBuffer);
+        }
+#else
+        cv::fastFree(slot.ownedBuffer);
+#endif
+    }
+
+    slot.ownedBuffer = nullptr;
+    slot.buffer = nullptr;
+    slot.ownedBytes = 0;
+    slot.mapped = false;
+}
+
+void FramePool::reformat(int width, int height, int type) {
+    if (width == m_width && height == m_height && type == m_type) {
+        return;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_type = type;
+    std::cout << "[FramePool] Reformatting slots to " << width << "x" << height << "\n";
+}
+
+FrameSlot* FramePool::acquireWritable() {
+    // 轮询查找空闲槽位；引用计数为 0 的槽位不可能再被消费者访问到
+    for (size_t i = 0; i < m_slotCount; ++i) {
+        FrameSlot* slot = &m_slots[(m_nextSlot + i) % m_slotCount];
+        uint32_t expected = 0;
+        if (slot->refCount.compare_exchange_strong(expected, WRITER_BIT,
+                                                   std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+            m_nextSlot = (m_nextSlot + i + 1) % m_slotCount;
+
+            // 帧格式已切换：槽位已被独占，可以安全地按新尺寸重建
+            const cv::Mat& pooled = slot->pooledImage;
+            if (pooled.cols != m_width || pooled.rows != m_height || pooled.type() != m_type) {
+                freeSlot(*slot);
+                if (!allocateSlot(*slot, m_width, m_height, m_type, m_useHugePages)) {
+                    std::cerr << "[FramePool] Failed to reallocate slot\n";
+                    slot->refCount.store(0, std::memory_order_release);
+                    return nullptr;
+                }
+                slot->refCount.store(WRITER_BIT, std::memory_order_relaxed);
+            }
+            return slot;
+        }
+    }
+
+    m_exhausted.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void FramePool::publish(FrameSlot* slot) {
+    trackAllocation(slot);
+
+    // 最新帧本身持有一个引用
+    slot->consumed.store(false, std::memory_order_relaxed);
+    slot->refCount.store(1, std::memory_order_release);
+    FrameSlot* previous = m_latest.exchange(slot, std::memory_order_acq_rel);
+    m_latestSequence.store(slot->frame.sequence, std::memory_order_release);
+
+    if (previous) {
+        if (!previous->consumed.load(std::memory_order_relaxed)) {
+            m_unconsumed.fetch_add(1, std::memory_order_relaxed);
+        }
+        releaseRef(previous);
+    }
+}
+
+void FramePool::discard(FrameSlot* slot) {
+    if (slot->frame.owner) {
+        releaseOwner(slot);
+    } else if (slot->frame.image.empty()) {
+        // 读取失败时 OpenCV 会释放输出 Mat，恢复为池缓冲避免下次重新分配
+        slot->frame.image = slot->pooledImage;
+        slot->buffer = slot->ownedBuffer;
+    } else {
+        trackAllocation(slot);
+    }
+    slot->refCount.store(0, std::memory_order_release);
+}
+
+FrameHandle FramePool::acquireLatest() {
+    for (;;) {
+        FrameSlot* slot = m_latest.load(std::memory_order_acquire);
+        if (!slot) {
+            return FrameHandle();
+        }
+
+        // 只有已发布且仍被引用的槽位才能借用；
+        // 若恰好被回收则重新读取最新帧
+        uint32_t count = slot->refCount.load(std::memory_order_relaxed);
+        while (count != 0 && (count & WRITER_BIT) == 0) {
+            if (slot->refCount.compare_exchange_weak(count, count + 1,
+                                                     std::memory_order_acquire,
+                                                     std::memory_order_relaxed)) {
+                slot->consumed.store(true, std::memory_order_relaxed);
+                return FrameHandle(slot);
+            }
+        }
+    }
+}
+
+void FramePool::releaseRef(FrameSlot* slot) {
+    // 最后一个引用且帧引用着外部缓冲：先独占槽位（借用者和采集线程都会跳过它），
+    // 立即把缓冲归还给帧源，再置为空闲。引用计数非零期间 owner 不会被修改，可以直接读取
+    uint32_t count = slot->refCount.load(std::memory_order_relaxed);
+    uint32_t next;
+    do {
+        next = count == 1 && slot->frame.owner ? WRITER_BIT : count - 1;
+    } while (!slot->refCount.compare_exchange_weak(count, next, std::memory_order_acq_rel,
+                                                   std::memory_order_relaxed));
+
+    if (next == WRITER_BIT) {
+        releaseOwner(slot);
+        slot->refCount.store(0, std::memory_order_release);
+    }
+}
+
+void FramePool::releaseOwner(FrameSlot* slot) {
+    slot->frame.owner.reset();
+    slot->frame.image = slot->pooledImage;
+    slot->buffer = slot->ownedBuffer;
+}
+
+void FramePool::trackAllocation(FrameSlot* slot) {
+    // 零拷贝帧引用的是帧源缓冲，不属于重新分配
+    if (slot->frame.owner) {
+        m_zeroCopy.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // 尺寸或格式变化时采集后端会重新分配，记录下来以便排查
+    if (slot->frame.image.data != slot->buffer) {
+        slot->buffer = slot->frame.image.data;
+        m_allocations.fetch_add(1, std::memory_order_relaxed);
+        m_reallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+FramePool::Stats FramePool::getStats() const {
+    Stats stats;
+    stats.slotCount = m_slotCount;
+    stats.hugePages = m_hugePages;
+    stats.allocations = m_allocations.load(std::memory_order_relaxed);
+    stats.reallocations = m_reallocations.load(std::memory_order_relaxed);
+    stats.exhausted = m_exhausted.load(std::memory_order_relaxed);
+    stats.zeroCopy = m_zeroCopy.load(std::memory_order_relaxed);
+    stats.unconsumed = m_unconsumed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace popcorn
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "CameraFrame.h"
+
+namespace popcorn {
+
+class FramePool;
+
+/**
+ * 帧池槽位
+ * 像素缓冲在初始化时一次性分配，采集线程反复读入同一块内存
+ */
+struct FrameSlot {
+    CameraFrame frame;
+
+    // 引用计数：0 = 空闲；WRITER_BIT = 独占（采集线程写入，或最后一个借用者归还外部缓冲）；其余为借用数
+    std::atomic<uint32_t> refCount{0};
+
+    // 发布后是否被消费者借用过（未借用就被覆盖计为丢帧）
+    std::atomic<bool> consumed{false};
+
+    cv::Mat pooledImage;            // 指向池缓冲的原始 Mat 头
+    uint8_t* buffer{nullptr};       // 当前像素缓冲（用于检测重新分配）
+    uint8_t* ownedBuffer{nullptr};  // 池自己分配的缓冲
+    size_t ownedBytes{0};
+    bool mapped{false};             // 通过 mmap 分配（需 munmap 释放）
+};
+
+/**
+ * 帧句柄
+ * 对池中一帧的引用计数借用，析构时自动归还；不复制像素
+ * 句柄不得比其所属的 FramePool 存活更久
+ */
+class FrameHandle {
+public:
+    FrameHandle() = default;
+    ~FrameHandle() { reset(); }
+
+    FrameHandle(const FrameHandle& other);
+    FrameHandle& operator=(const FrameHandle& other);
+    FrameHandle(FrameHandle&& other) noexcept : m_slot(other.m_slot) { other.m_slot = nullptr; }
+    FrameHandle& operator=(FrameHandle&& other) noexcept;
+
+    /**
+     * 释放借用
+     */
+    void reset();
+
+    explicit operator bool() const { return m_slot != nullptr; }
+    const CameraFrame& operator*() const { return m_slot->frame; }
+    const CameraFrame* operator->() const { return &m_slot->frame; }
+
+private:
+    friend class FramePool;
+    explicit FrameHandle(FrameSlot* slot) : m_slot(slot) {}
+
+    FrameSlot* m_slot{nullptr};
+};
+
+/**
+ * 预分配的摄像头帧池
+ *
+ * 单生产者（采集线程）/ 多消费者：
+ * - 采集线程 acquireWritable() 取一个空闲槽位读入，再 publish() 设为最新帧
+ * - 消费者 acquireLatest() 借用最新帧，整个过程无锁、无拷贝
+ * 稳态下不发生任何堆分配，可通过 getStats() 的分配计数验证
+ * 帧源也可以让槽位直接引用自己的缓冲（CameraFrame::owner），此时不计为重新分配；
+ * 外部缓冲在最后一个引用释放时立即归还帧源（而不是等槽位被复用），帧源的缓冲池不会被空闲槽位占住
+ */
+class FramePool {
+public:
+    /**
+     * 池统计信息
+     */
+    struct Stats {
+        size_t slotCount{0};
+        bool hugePages{false};          // 是否使用了大页
+        uint64_t allocations{0};        // 像素缓冲分配总次数（含初始化时的预分配）
+        uint64_t reallocations{0};      // 采集过程中发生的重新分配次数（稳态应为 0）
+        uint64_t exhausted{0};          // 无空闲槽位而丢弃的帧数
+        uint64_t zeroCopy{0};           // 直接引用帧源缓冲（未写入池缓冲）的帧数
+        uint64_t unconsumed{0};         // 发布后未被任何消费者借用就被新帧覆盖的帧数
+    };
+
+    FramePool() = default;
+    ~FramePool();
+
+    // 禁止拷贝
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    /**
+     * 初始化并预分配所有槽位
+     * @param slotCount 槽位数（至少 3）
+     * @param width 帧宽度
+     * @param height 帧高度
+     * @param type OpenCV 像素类型（如 CV_8UC3）
+     * @param useHugePages 尝试使用大页内存（仅 Linux，失败时回退）
+     * @return 成功返回 true
+     */
+    bool initialize(size_t slotCount, int width, int height, int type, bool useHugePages);
+
+    /**
+     * 释放所有槽位（调用前所有 FrameHandle 必须已归还）
+     */
+    void release();
+
+    /**
+     * 生产者：更改后续帧的尺寸和像素类型（采集分辨率切换时调用）
+     * 空闲槽位在下次被 acquireWritable() 取出时按新尺寸重建，
+     * 仍被借用的旧帧不受影响，归还后同样重建
+     * @param width 帧宽度
+     * @param height 帧高度
+     * @param type OpenCV 像素类型
+     */
+    void reformat(int width, int height, int type);
+
+    /**
+     * 生产者：独占一个空闲槽位
+     * @return 无空闲槽位时返回 nullptr
+     */
+    FrameSlot* acquireWritable();
+
+    /**
+     * 生产者：将写好的槽位发布为最新帧
+     */
+    void publish(FrameSlot* slot);
+
+    /**
+     * 生产者：放弃写入，归还槽位
+     */
+    void discard(FrameSlot* slot);
+
+    /**
+     * 消费者：借用最新帧（可多线程调用）
+     * @return 尚无帧时返回空句柄
+     */
+    FrameHandle acquireLatest();
+
+    /**
+     * 最新已发布帧的序号（0 表示尚无帧）
+     */
+    uint64_t getLatestSequence() const { return m_latestSequence.load(std::memory_order_acquire); }
+
+    /**
+     * 获取统计信息（任意线程）
+     */
+    Stats getStats() const;
+
+private:
+    friend class FrameHandle;
+    static void releaseRef(FrameSlot* slot);
+
+    // 归还槽位引用的外部缓冲并恢复为池缓冲（调用方须独占槽位）
+    static void releaseOwner(FrameSlot* slot);
+
+    // 检查采集后端是否替换了像素缓冲
+    void trackAllocation(FrameSlot* slot);
+
+    bool allocateSlot(FrameSlot& slot, int width, int height, int type, bool useHugePages);
+    void freeSlot(FrameSlot& slot);
+
+private:
+    std::unique_ptr<FrameSlot[]> m_slots;
+    size_t m_slotCount{0};
+    size_t m_nextSlot{0};               // 仅生产者访问
+
+    std::atomic<FrameSlot*> m_latest{nullptr};
+    std::atomic<uint64_t> m_latestSequence{0};
+
+    bool m_hugePages{false};
+    bool m_useHugePages{false};         // 初始化时的请求，重建槽位时沿用
+
+    // 当前帧格式（仅生产者访问）
+    int m_width{0};
+    int m_height{0};
+    int m_type{0};
+    std::atomic<uint64_t> m_allocations{0};
+    std::atomic<uint64_t> m_reallocations{0};
+    std::atomic<uint64_t> m_exhausted{0};
+    std::atomic<uint64_t> m_zeroCopy{0};
+    std::atomic<uint64_t> m_unconsumed{0};
+};
+
+} // namespace popcorn
@@ -0,0 +1,88 @@
+#include "FrameSource.h"
+#include "DeviceFrameSource.h"
+#include "FileFrameSource.h"
+#include "SessionFrameSource.h"
+#include "SyntheticFrameSource.h"
+#ifdef HAS_V4L2
+#include "V4L2FrameSource.h"
+#endif
+#ifdef HAS_GSTREAMER
+#include "GStreamerFrameSource.h"
+#endif
+#include <chrono>
+#include <iostream>
+
+namespace popcorn {
+
+std::unique_ptr<FrameSource> createFrameSource(const FrameSourceConfig& config) {
+    switch (config.type) {
+        case FrameSourceType::Camera:
+            return std::make_unique<DeviceFrameSource>(
+                config.deviceId, config.width, config.height, config.fps);
+
+        case FrameSourceType::VideoFile:
+            if (config.path.empty()) {
+                std::cerr << "[FrameSource] Video file source requires a path\n";
+                return nullptr;
+            }
+            return std::make_unique<VideoFileSource>(
+                config.path, config.pacing, config.fps, config.loop);
+
+        case FrameSourceType::ImageSequence:
+            if (config.path.empty()) {
+                std::cerr << "[FrameSource] Image sequence source requires a directory\n";
+                return nullptr;
+            }
+            return std::make_unique<ImageSequenceSource>(
+                config.path, config.pacing, config.fps, config.loop);
+
+        case FrameSourceType::V4L2:
+#ifdef HAS_V4L2
+            return std::make_unique<V4L2FrameSource>(
+                config.path.empty() ? "/dev/video" + std::to_string(config.deviceId) : config.path,
+                config.width, config.height, config.fps, config.format, config.keepYuv);
+#else
+            std::cerr << "[FrameSource] V4L2 capture is only available on Linux\n";
+            return nullptr;
+#endif
+
+        case FrameSourceType::GStreamer:
+#ifdef HAS_GSTREAMER
+            if (config.path.empty()) {
+                std::cerr << "[FrameSource] GStreamer source requires a pipeline description\n";
+                return nullptr;
+            }
+            return std::make_unique<GStreamerFrameSource>(config.path, config.keepYuv);
+#else
+            std::cerr << "[FrameSource] Built without GStreamer support\n";
+            return nullptr;
+#endif
+
+        case FrameSourceType::Session:
+            if (config.path.empty()) {
+                std::cerr << "[FrameSource] Session source requires a path\n";
+                return nullptr;
+            }
+            return std::make_unique<SessionFrameSource>(
+                config.path, config.pacing, config.fps, config.loop);
+
+        case FrameSourceType::Synthetic: {
+            SyntheticScene scene;
+            if (!SyntheticScene::fromSpec(config.path, scene)) {
+                std::cerr << "[FrameSource] Invalid synthetic scene: " << config.path << "\n";
+                return nullptr;
+            }
+            return std::make_unique<SyntheticFrameSource>(
+                scene, config.width, config.height, config.fps, config.pacing);
+        }
+    }
+    return nullptr;
+}
+
+int64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+} // namespace popcorn
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include "CameraFrame.h"
+
+namespace popcorn {
+
+/**
+ * 帧源类型
+ */
+enum class FrameSourceType {
+    Camera,         // 实时摄像头（OpenCV VideoCapture）
+    VideoFile,      // 录制的视频文件
+    ImageSequence,  // PNG/JPEG 图片序列
+    V4L2,           // Linux V4L2 原生 mmap 采集
+    GStreamer,      // GStreamer 管线（appsink）
+    Session,        // SessionRecorder 录制的会话（逐帧重放）
+    Synthetic       // 程序生成的运动玩家（负载 / 延迟测试）
+};
+
+/**
+ * 采集像素格式（V4L2 后端）
+ */
+enum class CaptureFormat {
+    Auto,   // 优先 YUYV，不支持时回退 MJPEG
+    YUYV,
+    MJPEG,
+    NV12
+};
+
+/**
+ * 文件回放的节奏控制
+ */
+enum class PacingMode {
+    RealTime,           // 按素材原始帧率实时播放
+    AsFastAsPossible,   // 不等待，尽可能快（用于压测）
+    FixedRate           // 按配置的 fps 固定速率播放
+};
+
+/**
+ * 帧源配置
+ */
+struct FrameSourceConfig {
+    FrameSourceType type{FrameSourceType::Camera};
+
+    int deviceId{0};            // 摄像头设备 ID
+    std::string path;           // 视频文件路径、图片序列目录、V4L2 设备节点、GStreamer 管线描述、会话文件或合成场景描述
+    CaptureFormat format{CaptureFormat::Auto};
+    bool keepYuv{false};        // YUV 采集时不转 BGR，交由 GPU 转换（V4L2 / GStreamer 后端）
+
+    int width{1280};            // 期望分辨率（摄像头 / 合成帧源）
+    int height{720};
+    double fps{30.0};           // 摄像头期望帧率 / FixedRate 与图片序列的播放帧率
+
+    PacingMode pacing{PacingMode::RealTime};
+    bool loop{true};            // 文件播放结束后是否从头循环
+
+    cv::Rect2f crop{0.0f, 0.0f, 1.0f, 1.0f};    // 处理区域（相对整帧的归一化坐标，见 CameraCapture::setCrop）
+    std::string calibrationPath;    // 镜头标定文件（检测到的关键点去畸变，见 LensUndistortion；空为不校正）
+
+    int detectionWidth{0};      // 检测器输入尺寸（0 表示不生成 CameraFrame::detectionImage）
+    int detectionHeight{0};
+};
+
+/**
+ * 帧源接口
+ * CameraCapture 的采集线程通过它读取帧，使实时摄像头与文件回放可以互换，
+ * 在没有摄像头的基准测试 / CI 机器上也能驱动完整的检测-游戏-渲染流水线
+ */
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    /**
+     * 打开帧源
+     * @return 成功返回 true
+     */
+    virtual bool open() = 0;
+
+    /**
+     * 关闭帧源
+     */
+    virtual void close() = 0;
+
+    /**
+     * 读取下一帧（阻塞，仅由采集线程调用）
+     * 应尽量写入 frame.image 已有的缓冲以避免重新分配，并填写 frame.timestampUs 和 frame.format
+     * @param frame 输出帧（序号由 CameraCapture 分配）
+     * @return 成功返回 true
+     */
+    virtual bool read(CameraFrame& frame) = 0;
+
+    /**
+     * 丢弃下一帧（帧池耗尽时调用，避免驱动队列积压）
+     * @return 实际消耗了一帧返回 true
+     */
+    virtual bool skip() { return false; }
+
+    /**
+     * 文件回放是否已结束（不循环时）
+     */
+    virtual bool isFinished() const { return false; }
+
+    /**
+     * 是否为实时设备（受看门狗监视，断开后重新打开）
+     * 文件回放、合成帧源的长时间等待是正常节奏，不视为卡住
+     */
+    virtual bool isLive() const { return false; }
+
+    /**
+     * 获取帧尺寸和帧率（open 之后有效）
+     */
+    virtual int getWidth() const = 0;
+    virtual int getHeight() const = 0;
+    virtual double getFps() const = 0;
+
+    /**
+     * 是否支持运行时切换分辨率和帧率（见 reconfigure）
+     */
+    virtual bool supportsReconfigure() const { return false; }
+
+    /**
+     * 运行时重新协商分辨率和帧率（仅由采集线程在两次 read() 之间调用）
+     * 设备不一定支持所请求的模式，成功后以 getWidth/getHeight/getFps 为准；
+     * 失败时应尽量恢复原模式，保持帧源可用
+     * @return 成功返回 true
+     */
+    virtual bool reconfigure(int width, int height, double fps) {
+        (void)width;
+        (void)height;
+        (void)fps;
+        return false;
+    }
+
+    /**
+     * 输出帧的像素格式（open 之后有效）
+     */
+    virtual PixelFormat getPixelFormat() const { return PixelFormat::BGR; }
+
+    /**
+     * 用于日志的描述
+     */
+    virtual std::string getName() const = 0;
+
+    /**
+     * 最近一次 read() 顺带生成的缩小 BGR 图（如 MJPEG 缩放解码）
+     * 采集线程优先用它生成检测图，免去从全分辨率缩放；没有时返回 nullptr
+     */
+    virtual const cv::Mat* getReducedImage() const { return nullptr; }
+
+    /**
+     * 设置检测器输入尺寸（open 之前调用，由 CameraCapture 设置）
+     * 帧源能以较低代价生成小图时据此决定缩小比例
+     */
+    void setDetectionSize(int width, int height) {
+        m_detectionWidth = width;
+        m_detectionHeight = height;
+    }
+
+protected:
+    int m_detectionWidth{0};
+    int m_detectionHeight{0};
+};
+
+/**
+ * 根据配置创建帧源
+ * @return 配置无效时返回 nullptr
+ */
+std::unique_ptr<FrameSource> createFrameSource(const FrameSourceConfig& config);
+
+/**
+ * 获取当前时间戳（steady_clock，微秒），与 CameraFrame::timestampUs 同一时基
+ */
+int64_t nowMicros();
+
+} // namespace popcorn
@@ -0,0 +1,303 @@
+#include "GStreamerFrameSource.h"
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <mutex>
+
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#include <gst/video/video.h>
+
+namespace popcorn {
+
+namespace {
+
+constexpr GstClockTime PULL_TIMEOUT = 200 * GST_MSECOND;
+constexpr GstClockTime START_TIMEOUT = 5 * GST_SECOND;
+constexpr const char* SINK_NAME = "popcorn_sink";
+
+// 驱动时间戳与当前时间相差超过该值时认为时基不一致，改用出队时间
+constexpr int64_t MAX_TIMESTAMP_SKEW_US = 1000000;
+
+void ensureGstInitialized() {
+    static std::once_flag once;
+    std::call_once(once, [] { gst_init(nullptr, nullptr); });
+}
+
+/**
+ * 映射中的采样
+ * 作为 CameraFrame::owner 挂在帧上，析构时解除映射并归还给 GStreamer
+ */
+struct MappedSample {
+    GstSample* sample{nullptr};
+    GstBuffer* buffer{nullptr};
+    GstMapInfo map{};
+
+    ~MappedSample() {
+        if (buffer) {
+            gst_buffer_unmap(buffer, &map);
+        }
+        if (sample) {
+            gst_sample_unref(sample);
+        }
+    }
+};
+
+bool toPixelFormat(GstVideoFormat format, PixelFormat& out) {
+    switch (format) {
+        case GST_VIDEO_FORMAT_BGR:  out = PixelFormat::BGR;  return true;
+        case GST_VIDEO_FORMAT_YUY2: out = PixelFormat::YUYV; return true;
+        case GST_VIDEO_FORMAT_NV12: out = PixelFormat::NV12; return true;
+        default:                    return false;
+    }
+}
+
+} // namespace
+
+struct GStreamerFrameSource::Impl {
+    GstElement* pipeline{nullptr};
+    GstAppSink* sink{nullptr};
+    GstSample* pending{nullptr};    // open 时为探测格式拉取的第一帧
+    GstVideoInfo info{};
+
+    bool live{false};
+    bool monotonicClock{false};     // 管线时钟为 CLOCK_MONOTONIC，可换算为 steady_clock
+    GstClockTime baseTime{0};
+
+    // 打印并清空总线上的错误；有错误返回 true
+    bool drainErrors() {
+        bool hasError = false;
+        GstBus* bus = gst_element_get_bus(pipeline);
+        while (GstMessage* msg = gst_bus_pop_filtered(bus, GST_MESSAGE_ERROR)) {
+            GError* error = nullptr;
+            gchar* debug = nullptr;
+            gst_message_parse_error(msg, &error, &debug);
+            std::cerr << "[GStreamer] Error from " << GST_OBJECT_NAME(msg->src) << ": "
+                      << (error ? error->message : "unknown") << "\n";
+            g_clear_error(&error);
+            g_free(debug);
+            gst_message_unref(msg);
+            hasError = true;
+        }
+        gst_object_unref(bus);
+        return hasError;
+    }
+};
+
+GStreamerFrameSource::GStreamerFrameSource(const std::string& pipeline, bool keepYuv)
+    : m_impl(std::make_unique<Impl>())
+    , m_pipeline(pipeline)
+    , m_keepYuv(keepYuv) {}
+
+GStreamerFrameSource::~GStreamerFrameSource() {
+    close();
+}
+
+bool GStreamerFrameSource::open() {
+    ensureGstInitialized();
+
+    // 末尾统一接 videoconvert + appsink；上游已是目标格式时 videoconvert 直通，不产生拷贝
+    std::string formats = m_keepYuv ? "{ NV12, YUY2, BGR }" : "BGR";
+    std::string description = m_pipeline +
+        " ! videoconvert ! video/x-raw,format=(string)" + formats +
+        " ! appsink name=" + SINK_NAME + " max-buffers=2 drop=true sync=false";
+
+    std::cout << "[GStreamer] Launching: " << description << "\n";
+
+    GError* error = nullptr;
+    m_impl->pipeline = gst_parse_launch(description.c_str(), &error);
+    if (error) {
+        std::cerr << "[GStreamer] Failed to parse pipeline: " << error->message << "\n";
+        g_clear_error(&error);
+        close();
+        return false;
+    }
+    if (!m_impl->pipeline) {
+        std::cerr << "[GStreamer] Failed to create pipeline\n";
+        return false;
+    }
+
+    GstElement* sink = gst_bin_get_by_name(GST_BIN(m_impl->pipeline), SINK_NAME);
+    if (!sink) {
+        std::cerr << "[GStreamer] appsink not found in pipeline\n";
+        close();
+        return false;
+    }
+    m_impl->sink = GST_APP_SINK(sink);
+
+    if (gst_element_set_state(m_impl->pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+        m_impl->drainErrors();
+        std::cerr << "[GStreamer] Failed to start pipeline\n";
+        close();
+        return false;
+    }
+
+    GstStateChangeReturn state = gst_element_get_state(m_impl->pipeline, nullptr, nullptr, START_TIMEOUT);
+    m_impl->live = state == GST_STATE_CHANGE_NO_PREROLL;
+
+    // 拉取第一帧以确定协商后的格式，之后由 read() 返回
+    m_impl->pending = gst_app_sink_try_pull_sample(m_impl->sink, START_TIMEOUT);
+    if (!m_impl->pending) {
+        m_impl->drainErrors();
+        std::cerr << "[GStreamer] No frames within " << START_TIMEOUT / GST_SECOND << "s\n";
+        close();
+        return false;
+    }
+
+    GstCaps* caps = gst_sample_get_caps(m_impl->pending);
+    if (!caps || !gst_video_info_from_caps(&m_impl->info, caps) ||
+        !toPixelFormat(GST_VIDEO_INFO_FORMAT(&m_impl->info), m_pixelFormat)) {
+        std::cerr << "[GStreamer] Unsupported caps on appsink\n";
+        close();
+        return false;
+    }
+
+    m_width = GST_VIDEO_INFO_WIDTH(&m_impl->info);
+    m_height = GST_VIDEO_INFO_HEIGHT(&m_impl->info);
+    m_fps = GST_VIDEO_INFO_FPS_D(&m_impl->info) > 0 && GST_VIDEO_INFO_FPS_N(&m_impl->info) > 0
+        ? static_cast<double>(GST_VIDEO_INFO_FPS_N(&m_impl->info)) / GST_VIDEO_INFO_FPS_D(&m_impl->info)
+        : 30.0;
+
+    // 实时源的 PTS 为采集时的运行时间，加上 base time 即时钟时间
+    m_impl->baseTime = gst_element_get_base_time(m_impl->pipeline);
+    if (GstClock* clock = gst_element_get_clock(m_impl->pipeline)) {
+        if (GST_IS_SYSTEM_CLOCK(clock)) {
+            GstClockType clockType = GST_CLOCK_TYPE_REALTIME;
+            g_object_get(clock, "clock-type", &clockType, nullptr);
+            m_impl->monotonicClock = clockType == GST_CLOCK_TYPE_MONOTONIC;
+        }
+        gst_object_unref(clock);
+    }
+
+    m_finished = false;
+
+    std::cout << "[GStreamer] Streaming "
+              << gst_video_format_to_string(GST_VIDEO_INFO_FORMAT(&m_impl->info)) << " "
+              << m_width << "x" << m_height << " @ " << m_fps << "fps"
+              << (m_impl->live ? " (live)" : "") << "\n";
+    return true;
+}
+
+void GStreamerFrameSource::close() {
+    if (m_impl->pending) {
+        gst_sample_unref(m_impl->pending);
+        m_impl->pending = nullptr;
+    }
+    if (m_impl->pipeline) {
+        gst_element_set_state(m_impl->pipeline, GST_STATE_NULL);
+    }
+    if (m_impl->sink) {
+        gst_object_unref(m_impl->sink);
+        m_impl->sink = nullptr;
+    }
+    if (m_impl->pipeline) {
+        gst_object_unref(m_impl->pipeline);
+        m_impl->pipeline = nullptr;
+    }
+}
+
+bool GStreamerFrameSource::read(CameraFrame& frame) {
+    if (!m_impl->sink) {
+        return false;
+    }
+
+    GstSample* sample = m_impl->pending;
+    m_impl->pending = nullptr;
+    if (!sample) {
+        sample = gst_app_sink_try_pull_sample(m_impl->sink, PULL_TIMEOUT);
+    }
+    if (!sample) {
+        if (gst_app_sink_is_eos(m_impl->sink)) {
+            m_finished = true;
+        } else if (m_impl->drainErrors()) {
+            // 管线出错后不会恢复，按结束处理
+            m_finished = true;
+        }
+        return false;
+    }
+
+    int64_t now = nowMicros();
+
+    auto mapped = std::make_shared<MappedSample>();
+    mapped->sample = sample;
+
+    GstBuffer* buffer = gst_sample_get_buffer(sample);
+    if (!buffer || !gst_buffer_map(buffer, &mapped->map, GST_MAP_READ)) {
+        return false;
+    }
+    mapped->buffer = buffer;
+
+    // 平面布局以缓冲自带的 video meta 为准（硬件缓冲池的行距可能与 caps 推算的不同）
+    const GstVideoInfo& info = m_impl->info;
+    size_t offsets[2] = {GST_VIDEO_INFO_PLANE_OFFSET(&info, 0), GST_VIDEO_INFO_PLANE_OFFSET(&info, 1)};
+    int strides[2] = {GST_VIDEO_INFO_PLANE_STRIDE(&info, 0), GST_VIDEO_INFO_PLANE_STRIDE(&info, 1)};
+    if (GstVideoMeta* meta = gst_buffer_get_video_meta(buffer)) {
+        offsets[0] = meta->offset[0];
+        offsets[1] = meta->offset[1];
+        strides[0] = meta->stride[0];
+        strides[1] = meta->stride[1];
+    }
+
+    uint8_t* data = mapped->map.data;
+    int matType = pixelFormatMatType(m_pixelFormat);
+
+    if (m_pixelFormat != PixelFormat::NV12) {
+        if (offsets[0] + static_cast<size_t>(strides[0]) * m_height > mapped->map.size) {
+            return false;
+        }
+        frame.image = cv::Mat(m_height, m_width, matType, data + offsets[0], strides[0]);
+        frame.owner = mapped;
+    } else if (offsets[1] == offsets[0] + static_cast<size_t>(strides[0]) * m_height &&
+               strides[1] == strides[0]) {
+        // UV 平面紧跟 Y 平面且行距相同，可直接视为 1.5 倍高的单通道图
+        if (offsets[0] + static_cast<size_t>(strides[0]) * (m_height * 3 / 2) > mapped->map.size) {
+            return false;
+        }
+        frame.image = cv::Mat(m_height * 3 / 2, m_width, matType, data + offsets[0], strides[0]);
+        frame.owner = mapped;
+    } else {
+        // 平面不连续：退回逐平面拷贝到帧池缓冲
+        if (offsets[1] + static_cast<size_t>(strides[1]) * (m_height / 2) > mapped->map.size) {
+            return false;
+        }
+        cv::Mat yDst = frame.image.rowRange(0, m_height);
+        cv::Mat uvDst = frame.image.rowRange(m_height, m_height * 3 / 2);
+        cv::Mat(m_height, m_width, CV_8UC1, data + offsets[0], strides[0]).copyTo(yDst);
+        cv::Mat(m_height / 2, m_width, CV_8UC1, data + offsets[1], strides[1]).copyTo(uvDst);
+    }
+
+    frame.format = m_pixelFormat;
+    frame.timestampUs = now;
+
+    GstClockTime pts = GST_BUFFER_PTS(buffer);
+    if (m_impl->live && m_impl->monotonicClock && GST_CLOCK_TIME_IS_VALID(pts)) {
+        int64_t captureUs = static_cast<int64_t>((m_impl->baseTime + pts) / GST_USECOND);
+        if (captureUs <= now && now - captureUs < MAX_TIMESTAMP_SKEW_US) {
+            frame.timestampUs = captureUs;
+        }
+    }
+    return true;
+}
+
+bool GStreamerFrameSource::skip() {
+    if (!m_impl->sink) {
+        return false;
+    }
+
+    GstSample* sample = m_impl->pending;
+    m_impl->pending = nullptr;
+    if (!sample) {
+        sample = gst_app_sink_try_pull_sample(m_impl->sink, PULL_TIMEOUT);
+    }
+    if (!sample) {
+        return false;
+    }
+    gst_sample_unref(sample);
+    return true;
+}
+
+bool GStreamerFrameSource::isLive() const {
+    // 实时源（摄像头、is-live 测试源）不做预滚；文件管线的等待是正常节奏
+    return m_impl && m_impl->live;
+}
+
+} // namespace popcorn
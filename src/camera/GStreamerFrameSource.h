@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include "FrameSource.h"
+
+namespace popcorn {
+
+/**
+ * GStreamer 管线帧源
+ *
+ * 接受一段管线描述（gst-launch 语法，不含 sink），在末尾接上 appsink：
+ *   v4l2src device=/dev/video0 ! image/jpeg,width=1280,height=720 ! jpegdec ! videoscale
+ *   videotestsrc is-live=true pattern=ball ! video/x-raw,width=1280,height=720,framerate=30/1
+ * 解码、缩放、格式转换都在 GStreamer 自己的线程中完成。
+ *
+ * 拉取的缓冲不再拷贝：帧直接引用映射后的 GstBuffer，
+ * 通过 CameraFrame::owner 持有 GstSample，最后一个借用者归还帧时立即归还给 GStreamer
+ */
+class GStreamerFrameSource : public FrameSource {
+public:
+    /**
+     * @param pipeline 管线描述（不含 sink）
+     * @param keepYuv 允许输出 YUY2 / NV12，由 GPU 转换颜色
+     */
+    GStreamerFrameSource(const std::string& pipeline, bool keepYuv = false);
+    ~GStreamerFrameSource() override;
+
+    bool open() override;
+    void close() override;
+    bool read(CameraFrame& frame) override;
+    bool skip() override;
+    bool isFinished() const override { return m_finished; }
+    bool isLive() const override;
+
+    int getWidth() const override { return m_width; }
+    int getHeight() const override { return m_height; }
+    double getFps() const override { return m_fps; }
+    PixelFormat getPixelFormat() const override { return m_pixelFormat; }
+    std::string getName() const override { return "gstreamer"; }
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+
+    std::string m_pipeline;
+    bool m_keepYuv{false};
+
+    int m_width{0};
+    int m_height{0};
+    double m_fps{0.0};
+    PixelFormat m_pixelFormat{PixelFormat::BGR};
+    bool m_finished{false};
+};
+
+} // namespace popcorn
@@ -0,0 +1,127 @@
+#include "LensUndistortion.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace popcorn {
+
+bool LensUndistortion::load(const std::string& path) {
+    cv::FileStorage fs(path, cv::FileStorage::READ);
+    if (!fs.isOpened()) {
+        std::cerr << "[Lens] Failed to open calibration file: " << path << "\n";
+        return false;
+    }
+
+    cv::Mat cameraMatrix;
+    cv::Mat distortion;
+    int width = 0;
+    int height = 0;
+    fs["camera_matrix"] >> cameraMatrix;
+    fs["distortion_coefficients"] >> distortion;
+    fs["image_width"] >> width;
+    fs["image_height"] >> height;
+
+    if (cameraMatrix.rows != 3 || cameraMatrix.cols != 3 || cameraMatrix.channels() != 1) {
+        std::cerr << "[Lens] camera_matrix in " << path << " is not a 3x3 matrix\n";
+        return false;
+    }
+    if (distortion.empty() || (distortion.rows != 1 && distortion.cols != 1)) {
+        std::cerr << "[Lens] Missing distortion_coefficients in " << path << "\n";
+        return false;
+    }
+    if (width <= 0 || height <= 0) {
+        std::cerr << "[Lens] Missing image_width / image_height in " << path << "\n";
+        return false;
+    }
+
+    cameraMatrix.convertTo(cameraMatrix, CV_64F);
+    distortion.convertTo(distortion, CV_64F);
+    const double* coefficients = distortion.ptr<double>();
+    setCalibration(cv::Matx33d(cameraMatrix.ptr<double>()),
+                   std::vector<double>(coefficients, coefficients + distortion.total()),
+                   cv::Size(width, height));
+
+    std::cout << "[Lens] Loaded calibration " << width << "x" << height << " ("
+              << m_distortion.size() << " distortion coefficients) from " << path << "\n";
+    return true;
+}
+
+void LensUndistortion::setCalibration(const cv::Matx33d& cameraMatrix, const std::vector<double>& distortion,
+                                      const cv::Size& calibrationSize) {
+    m_cameraMatrix = cameraMatrix;
+    m_distortion = distortion;
+    m_calibrationSize = calibrationSize;
+
+    // 标定变化后下次 prepare 重建网格
+    m_frameSize = cv::Size();
+    m_grid.clear();
+}
+
+void LensUndistortion::prepare(const cv::Size& frameSize) {
+    if (!isCalibrated() || frameSize.empty() || frameSize == m_frameSize) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // 帧尺寸与标定尺寸不同（采集模式切换）时按比例缩放内参；畸变系数与尺寸无关
+    double sx = static_cast<double>(frameSize.width) / m_calibrationSize.width;
+    double sy = static_cast<double>(frameSize.height) / m_calibrationSize.height;
+    cv::Matx33d scaled = m_cameraMatrix;
+    scaled(0, 0) *= sx;
+    scaled(0, 1) *= sx;
+    scaled(0, 2) *= sx;
+    scaled(1, 1) *= sy;
+    scaled(1, 2) *= sy;
+
+    // 网格覆盖整帧：最后一列 / 行节点落在帧边缘或之外
+    m_gridCols = (frameSize.width + GRID_STEP - 1) / GRID_STEP + 1;
+    m_gridRows = (frameSize.height + GRID_STEP - 1) / GRID_STEP + 1;
+
+    std::vector<cv::Point2f> nodes;
+    nodes.reserve(static_cast<size_t>(m_gridCols) * m_gridRows);
+    for (int j = 0; j < m_gridRows; ++j) {
+        for (int i = 0; i < m_gridCols; ++i) {
+            nodes.emplace_back(static_cast<float>(i * GRID_STEP), static_cast<float>(j * GRID_STEP));
+        }
+    }
+
+    // 新相机矩阵取缩放后的内参：输出仍是同一帧的像素坐标
+    cv::Mat cameraMatrix(3, 3, CV_64F, scaled.val);
+    cv::Mat distortion(1, static_cast<int>(m_distortion.size()), CV_64F, m_distortion.data());
+    cv::undistortPoints(nodes, m_grid, cameraMatrix, distortion, cv::Mat(), cameraMatrix);
+    m_frameSize = frameSize;
+
+    auto elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Lens] Undistortion grid " << m_gridCols << "x" << m_gridRows << " for "
+              << frameSize.width << "x" << frameSize.height << " (" << elapsed << "ms)\n";
+}
+
+cv::Point2f LensUndistortion::undistort(const cv::Point2f& point) const {
+    if (m_grid.empty()) {
+        return point;
+    }
+
+    // 所在网格单元；帧外的点用边缘单元外推（权重可超出 [0, 1]）
+    float gx = point.x / GRID_STEP;
+    float gy = point.y / GRID_STEP;
+    int i = std::min(std::max(static_cast<int>(std::floor(gx)), 0), m_gridCols - 2);
+    int j = std::min(std::max(static_cast<int>(std::floor(gy)), 0), m_gridRows - 2);
+    float fx = gx - i;
+    float fy = gy - j;
+
+    const cv::Point2f& p00 = m_grid[j * m_gridCols + i];
+    const cv::Point2f& p10 = m_grid[j * m_gridCols + i + 1];
+    const cv::Point2f& p01 = m_grid[(j + 1) * m_gridCols + i];
+    const cv::Point2f& p11 = m_grid[(j + 1) * m_gridCols + i + 1];
+
+    float w00 = (1.0f - fx) * (1.0f - fy);
+    float w10 = fx * (1.0f - fy);
+    float w01 = (1.0f - fx) * fy;
+    float w11 = fx * fy;
+    return cv::Point2f(w00 * p00.x + w10 * p10.x + w01 * p01.x + w11 * p11.x,
+                       w00 * p00.y + w10 * p10.y + w01 * p01.y + w11 * p11.y);
+}
+
+} // namespace popcorn
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+namespace popcorn {
+
+/**
+ * 关键点镜头去畸变
+ *
+ * 广角摄像头的画面边缘畸变明显，直接用检测到的关键点会与游戏中的掉落位置对不上。
+ * 逐帧 cv::remap 整幅图像需要数毫秒，这里只校正关键点：
+ * 按帧尺寸预先用标定参数计算一张稀疏的去畸变网格，之后每个点只做一次双线性插值（微秒级）。
+ * 输出仍为帧像素坐标（新相机矩阵取原相机矩阵），画面中心附近的点基本不动。
+ */
+class LensUndistortion {
+public:
+    // 网格间距（像素）：畸变场平滑，16px 间距的插值误差远小于关键点本身的误差
+    static constexpr int GRID_STEP = 16;
+
+    LensUndistortion() = default;
+
+    /**
+     * 读取 OpenCV 标定文件（calibration 示例程序的输出格式）
+     * 键：camera_matrix（3x3）、distortion_coefficients（4/5/8/12/14 个）、image_width、image_height
+     * @return 成功返回 true
+     */
+    bool load(const std::string& path);
+
+    /**
+     * 直接设置标定参数
+     * @param cameraMatrix 相机内参
+     * @param distortion 畸变系数
+     * @param calibrationSize 标定时的图像尺寸（帧尺寸不同时按比例缩放内参）
+     */
+    void setCalibration(const cv::Matx33d& cameraMatrix, const std::vector<double>& distortion,
+                        const cv::Size& calibrationSize);
+
+    /**
+     * 是否已有标定参数
+     */
+    bool isCalibrated() const { return !m_calibrationSize.empty(); }
+
+    /**
+     * 按帧尺寸准备去畸变网格（尺寸不变时直接返回；采集分辨率切换后自动重建）
+     */
+    void prepare(const cv::Size& frameSize);
+
+    /**
+     * 校正一个关键点（需先 prepare；帧外的点按边缘网格线性外推）
+     * @param point 原始帧像素坐标
+     * @return 去畸变后的帧像素坐标
+     */
+    cv::Point2f undistort(const cv::Point2f& point) const;
+
+private:
+    cv::Matx33d m_cameraMatrix;
+    std::vector<double> m_distortion;
+    cv::Size m_calibrationSize;
+
+    // 去畸变网格：节点 (i, j) 位于原始帧像素 (i * GRID_STEP, j * GRID_STEP)
+    cv::Size m_frameSize;
+    int m_gridCols{0};
+    int m_gridRows{0};
+    std::vector<cv::Point2f> m_grid;
+};
+
+} // namespace popcorn
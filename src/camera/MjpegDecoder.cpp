@@ -0,0 +1,128 @@
+#include "MjpegDecoder.h"
+
+#ifdef HAS_LIBJPEG
+#include <csetjmp>
+#include <cstdio>
+#include <jpeglib.h>
+#endif
+
+namespace popcorn {
+
+namespace {
+
+// 缩放后的尺寸不小于目标的该比例即可（略微放大对检测无影响）
+constexpr float MIN_SCALE_COVERAGE = 0.9f;
+
+#ifdef HAS_LIBJPEG
+// libjpeg 默认出错时直接 exit()，改为 longjmp 回到解码函数
+struct ErrorManager {
+    jpeg_error_mgr pub;
+    jmp_buf jump;
+};
+
+void onJpegError(j_common_ptr cinfo) {
+    longjmp(reinterpret_cast<ErrorManager*>(cinfo->err)->jump, 1);
+}
+
+// UVC 摄像头的 MJPEG 常带有轻微损坏的数据，不打印警告
+void onJpegMessage(j_common_ptr) {}
+#endif
+
+} // namespace
+
+struct MjpegDecoder::Impl {
+#ifdef HAS_LIBJPEG
+    jpeg_decompress_struct cinfo{};
+    ErrorManager error{};
+#endif
+};
+
+MjpegDecoder::MjpegDecoder() : m_impl(std::make_unique<Impl>()) {
+#ifdef HAS_LIBJPEG
+    m_impl->cinfo.err = jpeg_std_error(&m_impl->error.pub);
+    m_impl->error.pub.error_exit = onJpegError;
+    m_impl->error.pub.output_message = onJpegMessage;
+    jpeg_create_decompress(&m_impl->cinfo);
+#endif
+}
+
+MjpegDecoder::~MjpegDecoder() {
+#ifdef HAS_LIBJPEG
+    jpeg_destroy_decompress(&m_impl->cinfo);
+#endif
+}
+
+bool MjpegDecoder::decode(const uint8_t* data, size_t size, cv::Mat& out, int scaleDenom) {
+    if (!data || size == 0) {
+        return false;
+    }
+
+#ifdef HAS_LIBJPEG
+    // setjmp 之后到 longjmp 之间不得构造带析构函数的局部对象
+    jpeg_decompress_struct& cinfo = m_impl->cinfo;
+    if (setjmp(m_impl->error.jump)) {
+        jpeg_abort_decompress(&cinfo);
+        return false;
+    }
+
+    jpeg_mem_src(&cinfo, const_cast<unsigned char*>(data), static_cast<unsigned long>(size));
+    jpeg_read_header(&cinfo, TRUE);
+
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = static_cast<unsigned int>(scaleDenom);
+    // 缩小解码用于检测，使用更快的整数 IDCT
+    cinfo.dct_method = scaleDenom > 1 ? JDCT_IFAST : JDCT_ISLOW;
+#ifdef JCS_EXTENSIONS
+    // libjpeg-turbo 可直接输出 BGR
+    cinfo.out_color_space = JCS_EXT_BGR;
+#else
+    cinfo.out_color_space = JCS_RGB;
+#endif
+
+    jpeg_start_decompress(&cinfo);
+
+    out.create(static_cast<int>(cinfo.output_height), static_cast<int>(cinfo.output_width), CV_8UC3);
+    while (cinfo.output_scanline < cinfo.output_height) {
+        JSAMPROW row = out.ptr<JSAMPLE>(static_cast<int>(cinfo.output_scanline));
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_decompress(&cinfo);
+
+#ifndef JCS_EXTENSIONS
+    cv::cvtColor(out, out, cv::COLOR_RGB2BGR);
+#endif
+    return true;
+#else
+    cv::Mat jpeg(1, static_cast<int>(size), CV_8UC1, const_cast<uint8_t*>(data));
+    if (scaleDenom <= 1) {
+        cv::imdecode(jpeg, cv::IMREAD_COLOR, &out);
+        return !out.empty();
+    }
+
+    // OpenCV 的 IMREAD_REDUCED_* 同样走缩放 IDCT
+    int flags = scaleDenom >= 8 ? cv::IMREAD_REDUCED_COLOR_8
+              : scaleDenom >= 4 ? cv::IMREAD_REDUCED_COLOR_4
+              : cv::IMREAD_REDUCED_COLOR_2;
+    cv::imdecode(jpeg, flags, &out);
+    return !out.empty();
+#endif
+}
+
+int MjpegDecoder::chooseScaleDenom(int width, int height, int targetWidth, int targetHeight) {
+    if (width <= 0 || height <= 0 || targetWidth <= 0 || targetHeight <= 0) {
+        return 1;
+    }
+
+    for (int denom = 8; denom > 1; denom /= 2) {
+        // 缩放 IDCT 的输出尺寸向上取整
+        int scaledWidth = (width + denom - 1) / denom;
+        int scaledHeight = (height + denom - 1) / denom;
+        if (scaledWidth >= targetWidth * MIN_SCALE_COVERAGE &&
+            scaledHeight >= targetHeight * MIN_SCALE_COVERAGE) {
+            return denom;
+        }
+    }
+    return 1;
+}
+
+} // namespace popcorn
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <opencv2/opencv.hpp>
+
+namespace popcorn {
+
+/**
+ * MJPEG 帧解码器
+ *
+ * 有 libjpeg(-turbo) 时直接用它解码，并支持 1/2、1/4、1/8 的缩放 IDCT：
+ * 缩小解码只计算低频系数，代价远小于全尺寸解码再 cv::resize，
+ * 用于给检测分支生成小图。没有 libjpeg 时回退到 cv::imdecode 的
+ * IMREAD_REDUCED_*（同样是缩放解码，但要经过 OpenCV 的中间缓冲）。
+ *
+ * 非线程安全，每个采集线程持有自己的实例
+ */
+class MjpegDecoder {
+public:
+    MjpegDecoder();
+    ~MjpegDecoder();
+
+    // 禁止拷贝
+    MjpegDecoder(const MjpegDecoder&) = delete;
+    MjpegDecoder& operator=(const MjpegDecoder&) = delete;
+
+    /**
+     * 解码为 BGR
+     * @param data JPEG 数据
+     * @param size 数据长度
+     * @param out 输出图像（尺寸不变时复用其缓冲）
+     * @param scaleDenom 缩放分母：1、2、4 或 8
+     * @return 成功返回 true
+     */
+    bool decode(const uint8_t* data, size_t size, cv::Mat& out, int scaleDenom = 1);
+
+    /**
+     * 选择检测分支的缩放分母：在缩放后尺寸不明显小于目标尺寸的前提下尽量缩小
+     * @return 1、2、4 或 8；目标尺寸无效时返回 1
+     */
+    static int chooseScaleDenom(int width, int height, int targetWidth, int targetHeight);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace popcorn
@@ -0,0 +1,289 @@
+#include "MultiCameraCapture.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace popcorn {
+
+size_t FrameSet::frameCount() const {
+    return static_cast<size_t>(std::count_if(frames.begin(), frames.end(),
+        [](const FrameHandle& frame) { return static_cast<bool>(frame); }));
+}
+
+MultiCameraCapture::MultiCameraCapture() = default;
+
+MultiCameraCapture::~MultiCameraCapture() {
+    shutdown();
+}
+
+bool MultiCameraCapture::initialize(const std::vector<FrameSourceConfig>& configs,
+                                    int screenWidth, int screenHeight) {
+    if (configs.empty()) {
+        std::cerr << "[MultiCamera] No frame sources\n";
+        return false;
+    }
+
+    const size_t count = configs.size();
+
+    for (size_t i = 0; i < count; ++i) {
+        std::cout << "[MultiCamera] Opening camera " << i << "...\n";
+        auto camera = std::make_unique<CameraCapture>();
+        if (i < m_frameListeners.size()) {
+            camera->setFrameListener(m_frameListeners[i]);
+        }
+        if (!camera->initialize(configs[i])) {
+            std::cerr << "[MultiCamera] Failed to open camera " << i << "\n";
+            shutdown();
+            return false;
+        }
+        m_cameras.push_back(std::move(camera));
+    }
+
+    m_pending.assign(count, {});
+    for (auto& pending : m_pending) {
+        pending.reserve(HISTORY_DEPTH + 1);
+    }
+    m_lastSequence.assign(count, 0);
+    m_chosen.assign(count, -1);
+
+    // 默认布局：各摄像头从左到右等分屏幕宽度，原始帧拉伸铺满自己的一列
+    m_homographies.assign(count, cv::Matx33d::eye());
+    m_calibrationSizes.resize(count);
+    const double columnWidth = static_cast<double>(screenWidth) / count;
+    for (size_t i = 0; i < count; ++i) {
+        const CameraCapture& camera = *m_cameras[i];
+        m_calibrationSizes[i] = cv::Size(camera.getWidth(), camera.getHeight());
+        m_homographies[i] = cv::Matx33d(
+            columnWidth / camera.getWidth(), 0.0, columnWidth * i,
+            0.0, static_cast<double>(screenHeight) / camera.getHeight(), 0.0,
+            0.0, 0.0, 1.0);
+    }
+
+    m_nextSetId = 1;
+    m_syncStats = SyncStats{};
+
+    std::cout << "[MultiCamera] " << count << " cameras, sync tolerance "
+              << getSyncTolerance() / 1000.0 << "ms\n";
+    return true;
+}
+
+void MultiCameraCapture::shutdown() {
+    // 先归还借用的帧，再关闭各自的帧池
+    m_pending.clear();
+    m_cameras.clear();
+    m_lastSequence.clear();
+    m_chosen.clear();
+}
+
+bool MultiCameraCapture::loadHomographies(const std::string& path) {
+    cv::FileStorage fs(path, cv::FileStorage::READ);
+    if (!fs.isOpened()) {
+        std::cerr << "[MultiCamera] Failed to open homography file: " << path << "\n";
+        return false;
+    }
+
+    size_t loaded = 0;
+    for (size_t i = 0; i < m_homographies.size(); ++i) {
+        cv::FileNode node = fs["camera" + std::to_string(i)];
+        if (node.empty()) {
+            continue;
+        }
+
+        cv::Mat matrix;
+        node >> matrix;
+        if (matrix.rows != 3 || matrix.cols != 3 || matrix.channels() != 1) {
+            std::cerr << "[MultiCamera] camera" << i << " in " << path << " is not a 3x3 matrix\n";
+            return false;
+        }
+
+        matrix.convertTo(matrix, CV_64F);
+        setHomography(i, cv::Matx33d(matrix.ptr<double>()));
+        ++loaded;
+    }
+
+    std::cout << "[MultiCamera] Loaded " << loaded << " homographies from " << path << "\n";
+    return true;
+}
+
+void MultiCameraCapture::setHomography(size_t camera, const cv::Matx33d& homography) {
+    if (camera < m_homographies.size()) {
+        m_homographies[camera] = homography;
+    }
+}
+
+int64_t MultiCameraCapture::getSyncTolerance() const {
+    if (m_toleranceUs > 0) {
+        return m_toleranceUs;
+    }
+
+    // 各摄像头自由运行、相位任意：同帧率时总能找到相差不超过半个帧间隔的一对
+    double slowestFps = 0.0;
+    for (const auto& camera : m_cameras) {
+        double fps = camera->getFps();
+        if (fps > 0.0 && (slowestFps == 0.0 || fps < slowestFps)) {
+            slowestFps = fps;
+        }
+    }
+    return static_cast<int64_t>(500000.0 / (slowestFps > 0.0 ? slowestFps : 30.0));
+}
+
+cv::Point2f MultiCameraCapture::mapToScreen(size_t camera, const cv::Point2f& point,
+                                            const cv::Size& frameSize) const {
+    const cv::Size& calibration = m_calibrationSizes[camera];
+    double px = point.x;
+    double py = point.y;
+    if (frameSize.width > 0 && frameSize.height > 0 && frameSize != calibration) {
+        px *= static_cast<double>(calibration.width) / frameSize.width;
+        py *= static_cast<double>(calibration.height) / frameSize.height;
+    }
+
+    const cv::Matx33d& h = m_homographies[camera];
+    double x = h(0, 0) * px + h(0, 1) * py + h(0, 2);
+    double y = h(1, 0) * px + h(1, 1) * py + h(1, 2);
+    double w = h(2, 0) * px + h(2, 1) * py + h(2, 2);
+    if (std::abs(w) < 1e-9) {
+        return point;
+    }
+    return cv::Point2f(static_cast<float>(x / w), static_cast<float>(y / w));
+}
+
+void MultiCameraCapture::pollCameras() {
+    for (size_t i = 0; i < m_cameras.size(); ++i) {
+        FrameHandle frame;
+        if (!m_cameras[i]->getNewFrame(frame, m_lastSequence[i])) {
+            continue;
+        }
+
+        m_lastSequence[i] = frame->sequence;
+        auto& pending = m_pending[i];
+        pending.push_back(std::move(frame));
+        if (pending.size() > HISTORY_DEPTH) {
+            pending.erase(pending.begin());
+            ++m_syncStats.unmatchedFrames;
+        }
+    }
+}
+
+bool MultiCameraCapture::getFrameSet(FrameSet& set) {
+    if (m_cameras.empty()) {
+        return false;
+    }
+
+    pollCameras();
+
+    const size_t count = m_cameras.size();
+    while (true) {
+        bool waiting = false;
+        int64_t oldestPending = std::numeric_limits<int64_t>::max();
+        for (size_t i = 0; i < count; ++i) {
+            if (!m_pending[i].empty()) {
+                oldestPending = std::min(oldestPending, m_pending[i].front()->timestampUs);
+            } else if (!m_cameras[i]->isFinished()) {
+                waiting = true;
+            }
+        }
+
+        if (oldestPending == std::numeric_limits<int64_t>::max()) {
+            return false;
+        }
+
+        // 有摄像头还没有新帧：等它，超时或它已播放完毕则交出部分组（各取最新帧）
+        bool incomplete = std::any_of(m_pending.begin(), m_pending.end(),
+            [](const std::vector<FrameHandle>& pending) { return pending.empty(); });
+        if (incomplete) {
+            if (waiting && nowMicros() - oldestPending < m_maxWaitUs) {
+                return false;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                m_chosen[i] = m_pending[i].empty() ? -1 : static_cast<int>(m_pending[i].size()) - 1;
+            }
+            emitSet(set, m_chosen, false);
+            return true;
+        }
+
+        // 以各摄像头最新帧中最旧的一帧为基准，每个摄像头取最接近基准的帧
+        int64_t reference = std::numeric_limits<int64_t>::max();
+        for (const auto& pending : m_pending) {
+            reference = std::min(reference, pending.back()->timestampUs);
+        }
+
+        int64_t earliest = std::numeric_limits<int64_t>::max();
+        int64_t latest = std::numeric_limits<int64_t>::min();
+        size_t earliestCamera = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const auto& pending = m_pending[i];
+            int best = 0;
+            for (int j = 1; j < static_cast<int>(pending.size()); ++j) {
+                if (std::abs(pending[j]->timestampUs - reference) <
+                    std::abs(pending[best]->timestampUs - reference)) {
+                    best = j;
+                }
+            }
+            m_chosen[i] = best;
+
+            int64_t timestamp = pending[best]->timestampUs;
+            if (timestamp < earliest) {
+                earliest = timestamp;
+                earliestCamera = i;
+            }
+            latest = std::max(latest, timestamp);
+        }
+
+        if (latest - earliest <= getSyncTolerance()) {
+            emitSet(set, m_chosen, true);
+            return true;
+        }
+
+        // 最早的那一帧在其他摄像头中没有同步伙伴（掉帧或卡顿）：丢弃它和更旧的帧后重新配对
+        auto& pending = m_pending[earliestCamera];
+        pending.erase(pending.begin(), pending.begin() + m_chosen[earliestCamera] + 1);
+        m_syncStats.unmatchedFrames += static_cast<uint64_t>(m_chosen[earliestCamera]) + 1;
+    }
+}
+
+void MultiCameraCapture::emitSet(FrameSet& set, const std::vector<int>& chosen, bool complete) {
+    const size_t count = m_cameras.size();
+    set.frames.resize(count);
+
+    int64_t earliest = std::numeric_limits<int64_t>::max();
+    int64_t latest = std::numeric_limits<int64_t>::min();
+    for (size_t i = 0; i < count; ++i) {
+        if (chosen[i] < 0) {
+            set.frames[i].reset();
+            continue;
+        }
+
+        auto& pending = m_pending[i];
+        set.frames[i] = std::move(pending[chosen[i]]);
+        pending.erase(pending.begin(), pending.begin() + chosen[i] + 1);
+
+        earliest = std::min(earliest, set.frames[i]->timestampUs);
+        latest = std::max(latest, set.frames[i]->timestampUs);
+    }
+
+    set.timestampUs = earliest;
+    set.spreadUs = latest - earliest;
+    set.id = m_nextSetId++;
+    set.complete = complete;
+
+    if (complete) {
+        ++m_syncStats.completeSets;
+    } else {
+        ++m_syncStats.partialSets;
+    }
+}
+
+bool MultiCameraCapture::isFinished() const {
+    if (m_cameras.empty()) {
+        return false;
+    }
+    for (size_t i = 0; i < m_cameras.size(); ++i) {
+        if (!m_cameras[i]->isFinished() || !m_pending[i].empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace popcorn
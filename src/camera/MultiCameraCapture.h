@@ -0,0 +1,178 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "CameraCapture.h"
+#include "FramePool.h"
+#include "FrameSource.h"
+
+namespace popcorn {
+
+/**
+ * 一组按采集时间戳对齐的帧（每个摄像头一帧）
+ */
+struct FrameSet {
+    std::vector<FrameHandle> frames;    // 与摄像头一一对应；部分组中缺帧的摄像头为空句柄
+    int64_t timestampUs{0};             // 组内最早的采集时间戳
+    int64_t spreadUs{0};                // 组内时间戳的最大差
+    uint64_t id{0};                     // 组序号，从 1 开始
+    bool complete{false};               // 每个摄像头都有帧且在容差之内
+
+    /**
+     * 当前组中有帧的摄像头数
+     */
+    size_t frameCount() const;
+};
+
+/**
+ * 多摄像头同步采集
+ *
+ * 每个帧源由独立的 CameraCapture 在各自线程中并行采集，
+ * 主线程轮询时把各摄像头的新帧放入短暂的历史中，按采集时间戳配成一组：
+ * 以各摄像头最新帧中最旧的一帧为基准，每个摄像头取时间戳最接近的一帧，
+ * 组内时间差不超过容差即交给检测。某个摄像头卡住时，
+ * 其余摄像头的帧等待超过上限后作为部分组交出，游戏不会因此停顿。
+ *
+ * 每个摄像头带一个 3x3 单应矩阵，把原始帧像素坐标映射到共享的屏幕坐标。
+ */
+class MultiCameraCapture {
+public:
+    /**
+     * 同步统计
+     */
+    struct SyncStats {
+        uint64_t completeSets{0};       // 完整且在容差内的组
+        uint64_t partialSets{0};        // 因等待超时缺帧交出的组
+        uint64_t unmatchedFrames{0};    // 找不到同步伙伴而丢弃的帧
+    };
+
+    MultiCameraCapture();
+    ~MultiCameraCapture();
+
+    // 禁止拷贝
+    MultiCameraCapture(const MultiCameraCapture&) = delete;
+    MultiCameraCapture& operator=(const MultiCameraCapture&) = delete;
+
+    /**
+     * 设置同步容差（0 表示取最慢帧源当前帧率下的半个帧间隔，随采集模式切换自动调整）
+     * @param toleranceUs 组内允许的最大时间戳差（微秒）
+     */
+    void setSyncTolerance(int64_t toleranceUs) { m_toleranceUs = toleranceUs; }
+
+    /**
+     * 设置缺帧等待上限：其余摄像头的帧等待超过该时间即作为部分组交出
+     * @param maxWaitUs 等待上限（微秒）
+     */
+    void setMaxWait(int64_t maxWaitUs) { m_maxWaitUs = maxWaitUs; }
+
+    /**
+     * 设置各摄像头的逐帧回调（需在 initialize 之前调用，下标与帧源配置对应）
+     */
+    void setFrameListeners(std::vector<CameraCapture::FrameListener> listeners) {
+        m_frameListeners = std::move(listeners);
+    }
+
+    /**
+     * 初始化所有帧源并启动各自的采集线程
+     * 单应矩阵默认把各摄像头从左到右并排铺满屏幕
+     * @param configs 每个摄像头的帧源配置
+     * @param screenWidth 共享屏幕空间宽度
+     * @param screenHeight 共享屏幕空间高度
+     * @return 全部打开成功返回 true
+     */
+    bool initialize(const std::vector<FrameSourceConfig>& configs, int screenWidth, int screenHeight);
+
+    /**
+     * 关闭所有摄像头
+     */
+    void shutdown();
+
+    /**
+     * 从标定文件加载单应矩阵（cv::FileStorage 格式，YAML / JSON / XML）
+     * 键为 camera0、camera1...，值为 3x3 矩阵，把原始帧像素映射到屏幕像素；
+     * 文件中没有的摄像头保持默认布局
+     * @param path 标定文件路径
+     * @return 成功返回 true
+     */
+    bool loadHomographies(const std::string& path);
+
+    /**
+     * 设置单个摄像头的单应矩阵
+     */
+    void setHomography(size_t camera, const cv::Matx33d& homography);
+    const cv::Matx33d& getHomography(size_t camera) const { return m_homographies[camera]; }
+
+    /**
+     * 把摄像头原始帧像素坐标映射到屏幕坐标
+     * 单应矩阵按初始化时的分辨率标定；采集分辨率切换后先把坐标换算回标定分辨率
+     * @param camera 摄像头序号
+     * @param point 原始帧像素坐标
+     * @param frameSize 该帧的尺寸
+     * @return 屏幕坐标
+     */
+    cv::Point2f mapToScreen(size_t camera, const cv::Point2f& point, const cv::Size& frameSize) const;
+
+    /**
+     * 取下一组同步帧（主线程）
+     * 没有可交出的新组时返回 false；set 的缓冲在多次调用间复用
+     * @param set 输出帧组
+     * @return 有新组返回 true
+     */
+    bool getFrameSet(FrameSet& set);
+
+    /**
+     * 摄像头数量
+     */
+    size_t getCameraCount() const { return m_cameras.size(); }
+
+    /**
+     * 获取单个摄像头（统计、分辨率等）
+     */
+    CameraCapture& getCamera(size_t index) { return *m_cameras[index]; }
+    const CameraCapture& getCamera(size_t index) const { return *m_cameras[index]; }
+
+    /**
+     * 同步容差（微秒）
+     */
+    int64_t getSyncTolerance() const;
+
+    /**
+     * 获取同步统计
+     */
+    SyncStats getSyncStats() const { return m_syncStats; }
+
+    /**
+     * 所有帧源都已播放完毕，且没有待交出的帧
+     */
+    bool isFinished() const;
+
+private:
+    // 把各摄像头的新帧放入历史
+    void pollCameras();
+
+    // 交出一组帧并从历史中移除它们及更旧的帧
+    void emitSet(FrameSet& set, const std::vector<int>& chosen, bool complete);
+
+private:
+    // 每个摄像头保留的待配对帧数（同时占用帧池槽位，不宜过多）
+    static constexpr size_t HISTORY_DEPTH = 2;
+
+    std::vector<std::unique_ptr<CameraCapture>> m_cameras;
+    std::vector<CameraCapture::FrameListener> m_frameListeners;
+    std::vector<std::vector<FrameHandle>> m_pending;    // 各摄像头待配对的帧，按序号递增
+    std::vector<uint64_t> m_lastSequence;               // 各摄像头已放入历史的最新序号
+    std::vector<int> m_chosen;                          // 配对结果（下标，-1 表示缺帧），复用缓冲
+    std::vector<cv::Matx33d> m_homographies;
+    std::vector<cv::Size> m_calibrationSizes;           // 单应矩阵对应的帧尺寸
+
+    int64_t m_toleranceUs{0};                           // 0 表示随帧率自动调整
+    int64_t m_maxWaitUs{100000};
+    uint64_t m_nextSetId{1};
+    SyncStats m_syncStats;
+};
+
+} // namespace popcorn
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace popcorn {
+
+/**
+ * 录制会话的磁盘格式
+ *
+ * 一次录制产生两个文件：
+ *   <name>      数据文件：文件头 + 逐帧的块（块头 + 像素或 JPEG 数据）
+ *   <name>.idx  索引文件：索引头 + 定长索引项，第 i 项描述第 i 帧
+ * 索引项定长，读取端映射索引文件后按下标直接定位任意一帧（O(1)）；
+ * 数据块自带块头，索引丢失或录制中断时仍可顺序扫描数据文件恢复。
+ *
+ * 所有字段按小端序写入（目标平台均为小端）。
+ */
+
+/**
+ * 帧数据编码
+ */
+enum class SessionEncoding : uint8_t {
+    Raw = 0,    // 原始像素（保留 BGR / YUYV / NV12 格式，行紧密排列）
+    Jpeg = 1    // JPEG（先转为 BGR），体积约为原始数据的 1/10
+};
+
+constexpr char SESSION_FILE_MAGIC[8] = {'P', 'C', 'S', 'E', 'S', 'S', '0', '1'};
+constexpr char SESSION_INDEX_MAGIC[8] = {'P', 'C', 'S', 'I', 'D', 'X', '0', '1'};
+constexpr uint32_t SESSION_CHUNK_MAGIC = 0x4D415246;   // "FRAM"
+constexpr uint32_t SESSION_VERSION = 1;
+
+/**
+ * 数据文件头
+ */
+struct SessionFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+static_assert(sizeof(SessionFileHeader) == 16, "SessionFileHeader layout");
+
+/**
+ * 帧块头（紧跟 payloadBytes 字节的帧数据）
+ */
+struct SessionChunkHeader {
+    uint32_t magic;
+    uint32_t payloadBytes;
+    uint64_t sequence;          // 录制时的帧序号
+    int64_t timestampUs;        // 录制时的采集时间戳（steady_clock，微秒）
+    uint16_t width;
+    uint16_t height;
+    uint8_t format;             // PixelFormat（Jpeg 编码时恒为 BGR）
+    uint8_t encoding;           // SessionEncoding
+    uint16_t reserved;
+};
+static_assert(sizeof(SessionChunkHeader) == 32, "SessionChunkHeader layout");
+
+/**
+ * 索引文件头
+ */
+struct SessionIndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entryBytes;        // sizeof(SessionIndexEntry)，便于将来扩展
+};
+static_assert(sizeof(SessionIndexHeader) == 16, "SessionIndexHeader layout");
+
+/**
+ * 索引项（每帧一项）
+ */
+struct SessionIndexEntry {
+    uint64_t offset;            // 块头在数据文件中的偏移
+    uint64_t sequence;
+    int64_t timestampUs;
+    uint32_t payloadBytes;
+    uint16_t width;
+    uint16_t height;
+    uint8_t format;
+    uint8_t encoding;
+    uint8_t reserved[6];
+};
+static_assert(sizeof(SessionIndexEntry) == 40, "SessionIndexEntry layout");
+
+/**
+ * 数据文件对应的索引文件路径
+ */
+inline std::string sessionIndexPath(const std::string& path) {
+    return path + ".idx";
+}
+
+} // namespace popcorn
@@ -0,0 +1,90 @@
+#include "SessionFrameSource.h"
+#include <iostream>
+
+namespace popcorn {
+
+SessionFrameSource::SessionFrameSource(const std::string& path, PacingMode pacing, double fixedFps,
+                                       bool loop, size_t startFrame)
+    : m_path(path)
+    , m_pacer(pacing, fixedFps)
+    , m_pacing(pacing)
+    , m_loop(loop)
+    , m_startFrame(startFrame) {}
+
+SessionFrameSource::~SessionFrameSource() {
+    close();
+}
+
+bool SessionFrameSource::open() {
+    if (!m_reader.open(m_path)) {
+        return false;
+    }
+
+    const size_t count = m_reader.getFrameCount();
+    if (count == 0) {
+        std::cerr << "[SessionFrameSource] No frames in " << m_path << "\n";
+        m_reader.close();
+        return false;
+    }
+
+    const SessionIndexEntry& first = m_reader.getEntry(0);
+    const SessionIndexEntry& last = m_reader.getEntry(count - 1);
+    m_width = first.width;
+    m_height = first.height;
+    m_pixelFormat = static_cast<SessionEncoding>(first.encoding) == SessionEncoding::Jpeg
+        ? PixelFormat::BGR : static_cast<PixelFormat>(first.format);
+
+    // 按录制时间戳估计平均帧率
+    int64_t durationUs = last.timestampUs - first.timestampUs;
+    m_fps = count > 1 && durationUs > 0 ? (count - 1) * 1000000.0 / durationUs : 30.0;
+
+    seek(m_startFrame < count ? m_startFrame : 0);
+    m_finished = false;
+    return true;
+}
+
+void SessionFrameSource::close() {
+    m_reader.close();
+}
+
+void SessionFrameSource::seek(size_t frameIndex) {
+    m_nextFrame = frameIndex;
+    m_frameIndex = 0;
+    m_pacer.reset();
+    if (frameIndex < m_reader.getFrameCount()) {
+        m_baseTimestampUs = m_reader.getEntry(frameIndex).timestampUs;
+    }
+}
+
+bool SessionFrameSource::read(CameraFrame& frame) {
+    if (m_finished || !m_reader.isOpen()) {
+        return false;
+    }
+
+    if (m_nextFrame >= m_reader.getFrameCount()) {
+        if (!m_loop) {
+            std::cout << "[SessionFrameSource] End of session\n";
+            m_finished = true;
+            return false;
+        }
+        seek(m_startFrame < m_reader.getFrameCount() ? m_startFrame : 0);
+    }
+
+    size_t index = m_nextFrame++;
+    if (!m_reader.readFrame(index, frame)) {
+        return false;
+    }
+
+    // 实时回放按录制时的时间戳间隔，保留现场的抖动和空档
+    if (m_pacing == PacingMode::RealTime) {
+        m_pacer.waitOffset(frame.timestampUs - m_baseTimestampUs);
+        ++m_frameIndex;
+    } else {
+        m_pacer.wait(m_frameIndex++, m_fps);
+    }
+
+    frame.timestampUs = nowMicros();
+    return true;
+}
+
+} // namespace popcorn
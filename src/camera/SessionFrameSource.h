@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include "FileFrameSource.h"
+#include "FrameSource.h"
+#include "SessionReader.h"
+
+namespace popcorn {
+
+/**
+ * 录制会话回放帧源
+ *
+ * 逐帧重放 SessionRecorder 录下的原始帧：RealTime 模式按录制时的时间戳间隔播放，
+ * 现场的帧间隔抖动、掉帧空档和分辨率切换都会原样重现。
+ * 原始编码的帧直接引用映射内存，不经过帧池拷贝。
+ */
+class SessionFrameSource : public FrameSource {
+public:
+    /**
+     * @param path 会话数据文件
+     * @param pacing 回放节奏
+     * @param fixedFps FixedRate 模式的帧率
+     * @param loop 播完后是否循环
+     * @param startFrame 从第几帧开始播放
+     */
+    SessionFrameSource(const std::string& path, PacingMode pacing, double fixedFps, bool loop,
+                       size_t startFrame = 0);
+    ~SessionFrameSource() override;
+
+    bool open() override;
+    void close() override;
+    bool read(CameraFrame& frame) override;
+    bool isFinished() const override { return m_finished; }
+
+    int getWidth() const override { return m_width; }
+    int getHeight() const override { return m_height; }
+    double getFps() const override { return m_fps; }
+    PixelFormat getPixelFormat() const override { return m_pixelFormat; }
+    std::string getName() const override { return "session:" + m_path; }
+
+    /**
+     * 跳到指定帧（采集线程外调用需保证没有并发的 read）
+     */
+    void seek(size_t frameIndex);
+
+private:
+    std::string m_path;
+    SessionReader m_reader;
+    FramePacer m_pacer;
+    PacingMode m_pacing;
+    bool m_loop{true};
+    bool m_finished{false};
+
+    size_t m_startFrame{0};
+    size_t m_nextFrame{0};
+    uint64_t m_frameIndex{0};       // 自本轮播放开始以来的帧数
+    int64_t m_baseTimestampUs{0};   // 本轮第一帧的录制时间戳
+
+    int m_width{0};
+    int m_height{0};
+    double m_fps{30.0};
+    PixelFormat m_pixelFormat{PixelFormat::BGR};
+};
+
+} // namespace popcorn
@@ -0,0 +1,241 @@
+#include "SessionReader.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace popcorn {
+
+namespace {
+
+// 索引项指向的块（块头 + 负载）是否完全落在数据文件内；按减法比较，损坏的超大偏移不会溢出
+bool chunkInBounds(const SessionIndexEntry& entry, size_t fileSize) {
+    if (entry.offset > fileSize || fileSize - entry.offset < sizeof(SessionChunkHeader)) {
+        return false;
+    }
+    return fileSize - entry.offset - sizeof(SessionChunkHeader) >= entry.payloadBytes;
+}
+
+} // namespace
+
+// ============= MappedFile =============
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // 映射建立后不再需要文件描述符
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+    if (m_file) {
+        CloseHandle(m_file);
+        m_file = nullptr;
+    }
+#else
+    if (m_data) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+// ============= SessionReader =============
+
+struct SessionReader::Mapping {
+    MappedFile file;
+};
+
+SessionReader::SessionReader() = default;
+
+SessionReader::~SessionReader() {
+    close();
+}
+
+bool SessionReader::open(const std::string& path) {
+    close();
+
+    auto mapping = std::make_shared<Mapping>();
+    if (!mapping->file.open(path)) {
+        std::cerr << "[SessionReader] Failed to map " << path << "\n";
+        return false;
+    }
+    if (!m_indexFile.open(sessionIndexPath(path))) {
+        std::cerr << "[SessionReader] Failed to map index " << sessionIndexPath(path) << "\n";
+        return false;
+    }
+
+    const MappedFile& data = mapping->file;
+    const auto* fileHeader = reinterpret_cast<const SessionFileHeader*>(data.data());
+    if (data.size() < sizeof(SessionFileHeader) ||
+        std::memcmp(fileHeader->magic, SESSION_FILE_MAGIC, sizeof(fileHeader->magic)) != 0 ||
+        fileHeader->version != SESSION_VERSION) {
+        std::cerr << "[SessionReader] Not a session file: " << path << "\n";
+        m_indexFile.close();
+        return false;
+    }
+
+    const auto* indexHeader = reinterpret_cast<const SessionIndexHeader*>(m_indexFile.data());
+    if (m_indexFile.size() < sizeof(SessionIndexHeader) ||
+        std::memcmp(indexHeader->magic, SESSION_INDEX_MAGIC, sizeof(indexHeader->magic)) != 0 ||
+        indexHeader->version != SESSION_VERSION ||
+        indexHeader->entryBytes != sizeof(SessionIndexEntry)) {
+        std::cerr << "[SessionReader] Invalid index for " << path << "\n";
+        m_indexFile.close();
+        return false;
+    }
+
+    m_entries = reinterpret_cast<const SessionIndexEntry*>(m_indexFile.data() + sizeof(SessionIndexHeader));
+    m_frameCount = (m_indexFile.size() - sizeof(SessionIndexHeader)) / sizeof(SessionIndexEntry);
+
+    // 录制中断时索引可能领先于数据：丢弃指向文件末尾之外的尾部索引项
+    while (m_frameCount > 0 && !chunkInBounds(m_entries[m_frameCount - 1], data.size())) {
+        --m_frameCount;
+    }
+
+    m_mapping = std::move(mapping);
+
+    if (m_frameCount > 0) {
+        const SessionIndexEntry& first = m_entries[0];
+        const SessionIndexEntry& last = m_entries[m_frameCount - 1];
+        std::cout << "[SessionReader] " << path << ": " << m_frameCount << " frames, "
+                  << first.width << "x" << first.height << ", "
+                  << (last.timestampUs - first.timestampUs) / 1000000.0 << "s\n";
+    }
+    return true;
+}
+
+void SessionReader::close() {
+    // 映射由 m_mapping 共享：已交出的零拷贝帧释放后才真正解除映射
+    m_mapping.reset();
+    m_indexFile.close();
+    m_entries = nullptr;
+    m_frameCount = 0;
+}
+
+size_t SessionReader::findFrame(int64_t timestampUs) const {
+    const SessionIndexEntry* end = m_entries + m_frameCount;
+    const SessionIndexEntry* it = std::lower_bound(m_entries, end, timestampUs,
+        [](const SessionIndexEntry& entry, int64_t ts) { return entry.timestampUs < ts; });
+    return static_cast<size_t>(it - m_entries);
+}
+
+bool SessionReader::readFrame(size_t index, CameraFrame& frame) {
+    if (index >= m_frameCount) {
+        return false;
+    }
+
+    // 现场采集的文件可能损坏：中间的索引项同样可能越界，解引用之前逐帧检查
+    const SessionIndexEntry& entry = m_entries[index];
+    if (!chunkInBounds(entry, m_mapping->file.size())) {
+        std::cerr << "[SessionReader] Corrupt chunk at frame " << index << " (outside data file)\n";
+        return false;
+    }
+    const uint8_t* chunkData = m_mapping->file.data() + entry.offset;
+    const auto* chunk = reinterpret_cast<const SessionChunkHeader*>(chunkData);
+    if (chunk->magic != SESSION_CHUNK_MAGIC || chunk->payloadBytes != entry.payloadBytes) {
+        std::cerr << "[SessionReader] Corrupt chunk at frame " << index << "\n";
+        return false;
+    }
+
+    const uint8_t* payload = chunkData + sizeof(SessionChunkHeader);
+    auto format = static_cast<PixelFormat>(entry.format);
+
+    if (static_cast<SessionEncoding>(entry.encoding) == SessionEncoding::Jpeg) {
+        if (!m_decoder.decode(payload, entry.payloadBytes, frame.image)) {
+            return false;
+        }
+        format = PixelFormat::BGR;
+    } else {
+        cv::Size size = pixelFormatMatSize(format, entry.width, entry.height);
+        int type = pixelFormatMatType(format);
+        if (static_cast<size_t>(size.area()) * CV_ELEM_SIZE(type) != entry.payloadBytes) {
+            std::cerr << "[SessionReader] Payload size mismatch at frame " << index << "\n";
+            return false;
+        }
+        // 映射为只读：下游只读取帧像素
+        frame.image = cv::Mat(size, type, const_cast<uint8_t*>(payload));
+        frame.owner = m_mapping;
+    }
+
+    frame.format = format;
+    frame.sequence = entry.sequence;
+    frame.timestampUs = entry.timestampUs;
+    return true;
+}
+
+} // namespace popcorn
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "CameraFrame.h"
+#include "MjpegDecoder.h"
+#include "SessionFormat.h"
+
+namespace popcorn {
+
+/**
+ * 只读内存映射文件
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    // 禁止拷贝
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const uint8_t* m_data{nullptr};
+    size_t m_size{0};
+#ifdef _WIN32
+    void* m_file{nullptr};
+    void* m_mapping{nullptr};
+#endif
+};
+
+/**
+ * 会话读取器
+ *
+ * 同时映射数据文件和索引文件：第 i 帧的索引项位于固定偏移，
+ * 定位任意一帧为 O(1)，按时间戳查找为 O(log n)。
+ * 原始编码的帧直接引用映射内存（零拷贝），JPEG 帧解码到调用方的缓冲。
+ */
+class SessionReader {
+public:
+    SessionReader();
+    ~SessionReader();
+
+    // 禁止拷贝
+    SessionReader(const SessionReader&) = delete;
+    SessionReader& operator=(const SessionReader&) = delete;
+
+    /**
+     * 打开会话（数据文件 path 与索引文件 path + ".idx"）
+     * @return 成功返回 true
+     */
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return m_entries != nullptr; }
+
+    /**
+     * 帧数（不含录制中断时不完整的尾部）
+     */
+    size_t getFrameCount() const { return m_frameCount; }
+
+    /**
+     * 第 index 帧的索引项（O(1)）
+     */
+    const SessionIndexEntry& getEntry(size_t index) const { return m_entries[index]; }
+
+    /**
+     * 查找采集时间戳不早于 timestampUs 的第一帧（O(log n)）
+     * @return 帧下标；都早于该时间戳时返回 getFrameCount()
+     */
+    size_t findFrame(int64_t timestampUs) const;
+
+    /**
+     * 读取第 index 帧
+     * 原始帧的 image 直接指向映射内存，frame.owner 持有映射，帧存活期间映射有效；
+     * JPEG 帧解码到 frame.image 已有的缓冲（尺寸不变时复用）。
+     * 写入录制时的序号和时间戳
+     * @return 成功返回 true
+     */
+    bool readFrame(size_t index, CameraFrame& frame);
+
+private:
+    struct Mapping;
+    std::shared_ptr<Mapping> m_mapping;     // 数据文件映射，被零拷贝的帧共同持有
+
+    MappedFile m_indexFile;
+    const SessionIndexEntry* m_entries{nullptr};
+    size_t m_frameCount{0};
+
+    MjpegDecoder m_decoder;
+};
+
+} // namespace popcorn
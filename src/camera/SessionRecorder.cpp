@@ -0,0 +1,241 @@
+#include "SessionRecorder.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+namespace popcorn {
+
+namespace {
+
+// 写缓冲：合并小块写入，减少系统调用
+constexpr size_t FILE_BUFFER_BYTES = 4 * 1024 * 1024;
+
+} // namespace
+
+SessionRecorder::SessionRecorder() = default;
+
+SessionRecorder::~SessionRecorder() {
+    close();
+}
+
+bool SessionRecorder::open(const std::string& path, const Options& options) {
+    close();
+
+    m_options = options;
+    m_path = path;
+
+    m_data = std::fopen(path.c_str(), "wb");
+    m_index = std::fopen(sessionIndexPath(path).c_str(), "wb");
+    if (!m_data || !m_index) {
+        std::cerr << "[Recorder] Failed to create " << path << "\n";
+        close();
+        return false;
+    }
+    std::setvbuf(m_data, nullptr, _IOFBF, FILE_BUFFER_BYTES);
+
+    SessionFileHeader fileHeader{};
+    std::memcpy(fileHeader.magic, SESSION_FILE_MAGIC, sizeof(fileHeader.magic));
+    fileHeader.version = SESSION_VERSION;
+
+    SessionIndexHeader indexHeader{};
+    std::memcpy(indexHeader.magic, SESSION_INDEX_MAGIC, sizeof(indexHeader.magic));
+    indexHeader.version = SESSION_VERSION;
+    indexHeader.entryBytes = sizeof(SessionIndexEntry);
+
+    if (std::fwrite(&fileHeader, sizeof(fileHeader), 1, m_data) != 1 ||
+        std::fwrite(&indexHeader, sizeof(indexHeader), 1, m_index) != 1) {
+        std::cerr << "[Recorder] Failed to write headers to " << path << "\n";
+        close();
+        return false;
+    }
+    m_dataOffset = sizeof(fileHeader);
+    m_writeFailed = false;
+
+    // 缓冲的像素内存在第一次使用时按帧尺寸分配，之后复用
+    size_t count = std::max<size_t>(options.queueFrames, 2);
+    m_frames.assign(count, PendingFrame{});
+    m_free.clear();
+    m_free.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_free.push_back(count - 1 - i);
+    }
+    m_ready.assign(count, 0);
+    m_readyHead = 0;
+    m_readyCount = 0;
+
+    m_framesWritten = 0;
+    m_framesDropped = 0;
+    m_bytesWritten = 0;
+    m_stopping = false;
+    m_thread = std::thread(&SessionRecorder::writerThread, this);
+
+    std::cout << "[Recorder] Recording to " << path << " ("
+              << (options.encoding == SessionEncoding::Jpeg ? "jpeg" : "raw") << ", "
+              << count << " frame queue)\n";
+    return true;
+}
+
+void SessionRecorder::close() {
+    if (m_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_cv.notify_one();
+        m_thread.join();
+    }
+
+    if (m_data) {
+        std::fclose(m_data);
+        m_data = nullptr;
+    }
+    if (m_index) {
+        std::fclose(m_index);
+        m_index = nullptr;
+
+        Stats stats = getStats();
+        std::cout << "[Recorder] Closed " << m_path << ": " << stats.framesWritten << " frames, "
+                  << stats.bytesWritten / (1024 * 1024) << "MB, " << stats.framesDropped
+                  << " dropped\n";
+    }
+
+    m_frames.clear();
+    m_free.clear();
+    m_ready.clear();
+    m_readyCount = 0;
+}
+
+bool SessionRecorder::submit(const CameraFrame& frame) {
+    if (frame.image.empty()) {
+        return false;
+    }
+
+    size_t index = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping || m_free.empty()) {
+            m_framesDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        index = m_free.back();
+        m_free.pop_back();
+    }
+
+    // 锁外拷贝：该缓冲此时只属于采集线程
+    PendingFrame& pending = m_frames[index];
+    frame.image.copyTo(pending.image);
+    pending.format = frame.format;
+    pending.sequence = frame.sequence;
+    pending.timestampUs = frame.timestampUs;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ready[(m_readyHead + m_readyCount) % m_ready.size()] = index;
+        ++m_readyCount;
+    }
+    m_cv.notify_one();
+    return true;
+}
+
+void SessionRecorder::writerThread() {
+    for (;;) {
+        size_t index = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_readyCount > 0 || m_stopping; });
+            if (m_readyCount == 0) {
+                break;  // 已停止且队列写空
+            }
+            index = m_ready[m_readyHead];
+            m_readyHead = (m_readyHead + 1) % m_ready.size();
+            --m_readyCount;
+        }
+
+        if (!writeFrame(m_frames[index])) {
+            m_framesDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_free.push_back(index);
+        }
+    }
+
+    std::fflush(m_data);
+    std::fflush(m_index);
+}
+
+bool SessionRecorder::writeFrame(const PendingFrame& frame) {
+    // 写入失败后文件偏移已不可信，之后的帧全部放弃
+    if (m_writeFailed) {
+        return false;
+    }
+
+    const uint8_t* payload = frame.image.data;
+    size_t payloadBytes = frame.image.total() * frame.image.elemSize();
+    PixelFormat format = frame.format;
+    int width = frame.image.cols;
+    int height = frame.format == PixelFormat::NV12 ? frame.image.rows * 2 / 3 : frame.image.rows;
+
+    if (m_options.encoding == SessionEncoding::Jpeg) {
+        CameraFrame view;
+        view.image = frame.image;
+        view.format = frame.format;
+        cv::Mat bgr = frameToBGR(view, m_bgrScratch);
+        if (!cv::imencode(".jpg", bgr, m_encodeBuffer,
+                          {cv::IMWRITE_JPEG_QUALITY, m_options.jpegQuality})) {
+            return false;
+        }
+        payload = m_encodeBuffer.data();
+        payloadBytes = m_encodeBuffer.size();
+        format = PixelFormat::BGR;
+    }
+
+    SessionChunkHeader chunk{};
+    chunk.magic = SESSION_CHUNK_MAGIC;
+    chunk.payloadBytes = static_cast<uint32_t>(payloadBytes);
+    chunk.sequence = frame.sequence;
+    chunk.timestampUs = frame.timestampUs;
+    chunk.width = static_cast<uint16_t>(width);
+    chunk.height = static_cast<uint16_t>(height);
+    chunk.format = static_cast<uint8_t>(format);
+    chunk.encoding = static_cast<uint8_t>(m_options.encoding);
+
+    if (std::fwrite(&chunk, sizeof(chunk), 1, m_data) != 1 ||
+        std::fwrite(payload, 1, payloadBytes, m_data) != payloadBytes) {
+        std::cerr << "[Recorder] Write failed (disk full?), recording stopped\n";
+        m_writeFailed = true;
+        return false;
+    }
+
+    // 索引项在数据块之后写入；两者分别缓冲，录制中断时读取端会忽略超出数据文件的索引项
+    SessionIndexEntry entry{};
+    entry.offset = m_dataOffset;
+    entry.sequence = chunk.sequence;
+    entry.timestampUs = chunk.timestampUs;
+    entry.payloadBytes = chunk.payloadBytes;
+    entry.width = chunk.width;
+    entry.height = chunk.height;
+    entry.format = chunk.format;
+    entry.encoding = chunk.encoding;
+    if (std::fwrite(&entry, sizeof(entry), 1, m_index) != 1) {
+        std::cerr << "[Recorder] Index write failed, recording stopped\n";
+        m_writeFailed = true;
+        return false;
+    }
+
+    m_dataOffset += sizeof(chunk) + payloadBytes;
+    m_framesWritten.fetch_add(1, std::memory_order_relaxed);
+    m_bytesWritten.fetch_add(sizeof(chunk) + payloadBytes, std::memory_order_relaxed);
+    return true;
+}
+
+SessionRecorder::Stats SessionRecorder::getStats() const {
+    Stats stats;
+    stats.framesWritten = m_framesWritten.load(std::memory_order_relaxed);
+    stats.framesDropped = m_framesDropped.load(std::memory_order_relaxed);
+    stats.bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace popcorn
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CameraFrame.h"
+#include "SessionFormat.h"
+
+namespace popcorn {
+
+/**
+ * 会话录制器
+ *
+ * 采集线程调用 submit() 把帧拷入预留的环形缓冲后立即返回，
+ * 编码和写盘由独立的写线程完成；磁盘跟不上时丢弃新帧并计数，
+ * 绝不阻塞采集线程。格式见 SessionFormat.h。
+ */
+class SessionRecorder {
+public:
+    /**
+     * 录制选项
+     */
+    struct Options {
+        SessionEncoding encoding{SessionEncoding::Raw};
+        int jpegQuality{90};
+        size_t queueFrames{16};     // 待写帧缓冲数（720p BGR 每帧约 2.6MB）
+    };
+
+    /**
+     * 录制统计
+     */
+    struct Stats {
+        uint64_t framesWritten{0};
+        uint64_t framesDropped{0};  // 缓冲已满而未录制的帧
+        uint64_t bytesWritten{0};
+    };
+
+    SessionRecorder();
+    ~SessionRecorder();
+
+    // 禁止拷贝
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    /**
+     * 创建数据文件和索引文件，启动写线程
+     * @param path 数据文件路径（索引为 path + ".idx"）
+     * @param options 录制选项
+     * @return 成功返回 true
+     */
+    bool open(const std::string& path, const Options& options);
+    bool open(const std::string& path) { return open(path, Options{}); }
+
+    /**
+     * 写完已提交的帧后关闭文件
+     */
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+
+    /**
+     * 提交一帧（采集线程）
+     * 只拷贝像素到空闲缓冲，不做编码和 I/O
+     * @return 缓冲已满、帧被丢弃时返回 false
+     */
+    bool submit(const CameraFrame& frame);
+
+    /**
+     * 获取统计（任意线程）
+     */
+    Stats getStats() const;
+
+private:
+    struct PendingFrame {
+        cv::Mat image;              // 连续存储的像素拷贝
+        PixelFormat format{PixelFormat::BGR};
+        uint64_t sequence{0};
+        int64_t timestampUs{0};
+    };
+
+    void writerThread();
+
+    // 编码并写入一帧（写线程）
+    bool writeFrame(const PendingFrame& frame);
+
+private:
+    Options m_options;
+    std::string m_path;
+    std::FILE* m_data{nullptr};
+    std::FILE* m_index{nullptr};
+    uint64_t m_dataOffset{0};               // 仅写线程访问
+    bool m_writeFailed{false};
+
+    // 环形缓冲：空闲栈 + 待写队列，都只存下标，互斥锁内不做拷贝
+    std::vector<PendingFrame> m_frames;
+    std::vector<size_t> m_free;
+    std::vector<size_t> m_ready;
+    size_t m_readyHead{0};
+    size_t m_readyCount{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stopping{false};
+    std::thread m_thread;
+
+    std::vector<uint8_t> m_encodeBuffer;      // JPEG 编码输出，仅写线程访问
+    cv::Mat m_bgrScratch;
+
+    std::atomic<uint64_t> m_framesWritten{0};
+    std::atomic<uint64_t> m_framesDropped{0};
+    std::atomic<uint64_t> m_bytesWritten{0};
+};
+
+} // namespace popcorn
@@ -0,0 +1,269 @@
+#include "SyntheticFrameSource.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+namespace popcorn {
+
+namespace {
+
+cv::Point toPixel(const cv::Point2f& p) {
+    return cv::Point(static_cast<int>(std::lround(p.x)), static_cast<int>(std::lround(p.y)));
+}
+
+cv::Point2f offset(const cv::Point2f& p, float dx, float dy) {
+    return cv::Point2f(p.x + dx, p.y + dy);
+}
+
+float distance(const cv::Point2f& a, const cv::Point2f& b) {
+    return std::hypot(a.x - b.x, a.y - b.y);
+}
+
+// 一条手臂的肘、手位置：lift 为上臂与竖直向下方向的夹角，bend 为肘部弯曲角，side 为 +1（画面右）或 -1
+void armPose(const cv::Point2f& shoulder, float lift, float bend, float side,
+             float upperLength, float foreLength, cv::Point2f& elbow, cv::Point2f& hand) {
+    elbow = offset(shoulder, side * upperLength * std::sin(lift), upperLength * std::cos(lift));
+    hand = offset(elbow, side * foreLength * std::sin(lift + bend), foreLength * std::cos(lift + bend));
+}
+
+} // namespace
+
+// ============= SyntheticScene =============
+
+SyntheticScene::SyntheticScene(std::vector<SyntheticPlayer> players)
+    : m_players(std::move(players)) {}
+
+bool SyntheticScene::fromSpec(const std::string& spec, SyntheticScene& scene) {
+    std::vector<SyntheticPlayerStyle> styles;
+    std::stringstream stream(spec.empty() ? "figure,figure" : spec);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item == "figure") {
+            styles.push_back(SyntheticPlayerStyle::StickFigure);
+        } else if (item == "blob") {
+            styles.push_back(SyntheticPlayerStyle::Blob);
+        } else {
+            std::cerr << "[Synthetic] Unknown player style: " << item << "\n";
+            return false;
+        }
+    }
+    if (styles.empty()) {
+        return false;
+    }
+
+    // 衣服颜色轮换（BGR），肤色略有差别
+    static const cv::Scalar bodyColors[] = {
+        {200, 80, 40}, {40, 60, 200}, {60, 170, 60}, {160, 60, 160}
+    };
+
+    std::vector<SyntheticPlayer> players(styles.size());
+    const float count = static_cast<float>(styles.size());
+    for (size_t i = 0; i < players.size(); ++i) {
+        SyntheticPlayer& player = players[i];
+        const float index = static_cast<float>(i);
+        player.style = styles[i];
+        player.center = cv::Point2f((index + 0.5f) / count, 0.6f);
+        player.sway = cv::Point2f(0.25f / count, 0.02f);
+        player.height = styles.size() > 2 ? 0.5f : 0.6f;
+        player.swayPeriod = 4.0f + 0.7f * index;
+        player.armPeriod = 1.6f + 0.3f * index;
+        player.phase = 2.1f * index;
+        player.skinColor = cv::Scalar(110 + 10 * (i % 3), 150 + 10 * (i % 2), 215);
+        player.bodyColor = bodyColors[i % (sizeof(bodyColors) / sizeof(bodyColors[0]))];
+    }
+
+    scene = SyntheticScene(std::move(players));
+    return true;
+}
+
+void SyntheticScene::evaluate(int64_t timestampUs, const cv::Size& frameSize,
+                              std::vector<SyntheticPose>& poses) const {
+    const float t = static_cast<float>(static_cast<double>(timestampUs) / 1000000.0);
+    const float twoPi = static_cast<float>(2.0 * CV_PI);
+    const float width = static_cast<float>(frameSize.width);
+    const float height = static_cast<float>(frameSize.height);
+
+    poses.resize(m_players.size());
+    for (size_t i = 0; i < m_players.size(); ++i) {
+        const SyntheticPlayer& player = m_players[i];
+        SyntheticPose& pose = poses[i];
+
+        // 身体沿 8 字轨迹摆动（竖直方向频率加倍）
+        const float u = player.height * height;
+        const float sway = twoPi * t / player.swayPeriod + player.phase;
+        pose.hip = cv::Point2f(player.center.x * width + player.sway.x * width * std::sin(sway),
+                               player.center.y * height + player.sway.y * height * std::sin(2.0f * sway));
+
+        const cv::Point2f neck = offset(pose.hip, 0.0f, -0.30f * u);
+        pose.head = offset(neck, 0.0f, -0.12f * u);
+        pose.leftShoulder = offset(neck, 0.10f * u, 0.0f);
+        pose.rightShoulder = offset(neck, -0.10f * u, 0.0f);
+
+        // 双臂错开四分之一周期挥动，手最高举过肩
+        const float arm = twoPi * t / player.armPeriod + player.phase;
+        const float quarter = 0.25f * twoPi;
+        armPose(pose.leftShoulder, 0.9f + 0.7f * std::sin(arm), 0.5f + 0.5f * std::sin(arm + 1.0f),
+                1.0f, 0.15f * u, 0.14f * u, pose.leftElbow, pose.leftHand);
+        armPose(pose.rightShoulder, 0.9f + 0.7f * std::sin(arm + quarter),
+                0.5f + 0.5f * std::sin(arm + quarter + 1.0f),
+                -1.0f, 0.15f * u, 0.14f * u, pose.rightElbow, pose.rightHand);
+
+        const float step = 0.02f * u * std::sin(2.0f * sway);
+        pose.leftKnee = offset(pose.hip, 0.06f * u + step, 0.24f * u);
+        pose.rightKnee = offset(pose.hip, -0.06f * u + step, 0.24f * u);
+        pose.leftFoot = offset(pose.hip, 0.09f * u, 0.48f * u);
+        pose.rightFoot = offset(pose.hip, -0.09f * u, 0.48f * u);
+    }
+}
+
+void SyntheticScene::render(const std::vector<SyntheticPose>& poses, cv::Mat& bgr) const {
+    const size_t count = std::min(poses.size(), m_players.size());
+    for (size_t i = 0; i < count; ++i) {
+        const SyntheticPlayer& player = m_players[i];
+        const SyntheticPose& pose = poses[i];
+        const float u = distance(pose.hip, pose.head) / 0.42f;
+
+        if (player.style == SyntheticPlayerStyle::StickFigure) {
+            const int thickness = std::max(1, static_cast<int>(0.03f * u));
+            const cv::Point2f neck = offset(pose.head, 0.0f, 0.12f * u);
+            auto bone = [&](const cv::Point2f& a, const cv::Point2f& b) {
+                cv::line(bgr, toPixel(a), toPixel(b), player.bodyColor, thickness, cv::LINE_AA);
+            };
+            bone(neck, pose.hip);
+            bone(pose.leftShoulder, pose.rightShoulder);
+            bone(pose.leftShoulder, pose.leftElbow);
+            bone(pose.leftElbow, pose.leftHand);
+            bone(pose.rightShoulder, pose.rightElbow);
+            bone(pose.rightElbow, pose.rightHand);
+            bone(pose.hip, pose.leftKnee);
+            bone(pose.leftKnee, pose.leftFoot);
+            bone(pose.hip, pose.rightKnee);
+            bone(pose.rightKnee, pose.rightFoot);
+        }
+
+        // 肤色的头和手（Blob 画得更大，便于肤色分割）
+        const float headRadius = player.style == SyntheticPlayerStyle::Blob ? 0.08f : 0.065f;
+        const float handRadius = player.style == SyntheticPlayerStyle::Blob ? 0.05f : 0.035f;
+        cv::circle(bgr, toPixel(pose.head), std::max(2, static_cast<int>(headRadius * u)),
+                   player.skinColor, cv::FILLED, cv::LINE_AA);
+        cv::circle(bgr, toPixel(pose.leftHand), std::max(2, static_cast<int>(handRadius * u)),
+                   player.skinColor, cv::FILLED, cv::LINE_AA);
+        cv::circle(bgr, toPixel(pose.rightHand), std::max(2, static_cast<int>(handRadius * u)),
+                   player.skinColor, cv::FILLED, cv::LINE_AA);
+    }
+}
+
+float SyntheticScene::handError(int64_t timestampUs, const cv::Size& frameSize,
+                                const std::vector<cv::Point2f>& hands) const {
+    if (hands.empty() || m_players.empty()) {
+        return 0.0f;
+    }
+
+    evaluate(timestampUs, frameSize, m_scratch);
+
+    float total = 0.0f;
+    for (const cv::Point2f& hand : hands) {
+        float nearest = std::numeric_limits<float>::max();
+        for (const SyntheticPose& pose : m_scratch) {
+            nearest = std::min(nearest, distance(hand, pose.leftHand));
+            nearest = std::min(nearest, distance(hand, pose.rightHand));
+        }
+        total += nearest;
+    }
+    return total / static_cast<float>(hands.size());
+}
+
+// ============= SyntheticFrameSource =============
+
+SyntheticFrameSource::SyntheticFrameSource(const SyntheticScene& scene, int width, int height,
+                                           double fps, PacingMode pacing)
+    : m_scene(scene)
+    , m_pacer(pacing, fps)
+    , m_pacing(pacing)
+    , m_width(width)
+    , m_height(height)
+    , m_fps(fps) {}
+
+SyntheticFrameSource::~SyntheticFrameSource() {
+    close();
+}
+
+bool SyntheticFrameSource::open() {
+    if (m_width <= 0 || m_height <= 0 || m_fps <= 0.0) {
+        std::cerr << "[Synthetic] Invalid mode " << m_width << "x" << m_height << " @ " << m_fps << "fps\n";
+        return false;
+    }
+
+    buildBackground();
+    m_pacer.reset();
+    m_frameIndex = 0;
+
+    std::cout << "[Synthetic] " << m_scene.getPlayers().size() << " players at "
+              << m_width << "x" << m_height << " @ " << m_fps << "fps\n";
+    return true;
+}
+
+void SyntheticFrameSource::close() {
+    m_background.release();
+}
+
+bool SyntheticFrameSource::read(CameraFrame& frame) {
+    if (m_background.empty()) {
+        return false;
+    }
+
+    m_pacer.wait(m_frameIndex++, m_fps);
+
+    // 以采集时刻为准绘制，下游按同一时间戳即可复现真实位置
+    const int64_t timestampUs = nowMicros();
+    m_scene.evaluate(timestampUs, cv::Size(m_width, m_height), m_poses);
+
+    // 尺寸不变时 copyTo 复用帧缓冲
+    m_background.copyTo(frame.image);
+    m_scene.render(m_poses, frame.image);
+
+    frame.format = PixelFormat::BGR;
+    frame.timestampUs = timestampUs;
+    return true;
+}
+
+bool SyntheticFrameSource::reconfigure(int width, int height, double fps) {
+    if (width <= 0 || height <= 0 || fps <= 0.0) {
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_fps = fps;
+    m_pacer = FramePacer(m_pacing, fps);
+    m_frameIndex = 0;
+    buildBackground();
+
+    std::cout << "[Synthetic] Reconfigured to " << m_width << "x" << m_height << " @ " << m_fps << "fps\n";
+    return true;
+}
+
+std::string SyntheticFrameSource::getName() const {
+    return "synthetic:" + std::to_string(m_width) + "x" + std::to_string(m_height);
+}
+
+void SyntheticFrameSource::buildBackground() {
+    m_background.create(m_height, m_width, CV_8UC3);
+
+    // 墙面为竖直渐变，下方四分之一为地板；分段填充，每帧只需整块拷贝
+    const int floorTop = m_height * 3 / 4;
+    const int bands = 32;
+    for (int band = 0; band < bands; ++band) {
+        int top = floorTop * band / bands;
+        int bottom = floorTop * (band + 1) / bands;
+        double shade = 70.0 + 60.0 * band / bands;
+        cv::rectangle(m_background, cv::Rect(0, top, m_width, bottom - top),
+                      cv::Scalar(shade, shade, shade * 0.9), cv::FILLED);
+    }
+    cv::rectangle(m_background, cv::Rect(0, floorTop, m_width, m_height - floorTop),
+                  cv::Scalar(60, 90, 110), cv::FILLED);
+}
+
+} // namespace popcorn
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "FileFrameSource.h"
+#include "FrameSource.h"
+
+namespace popcorn {
+
+/**
+ * 合成玩家的画法
+ */
+enum class SyntheticPlayerStyle {
+    StickFigure,    // 火柴人：躯干四肢为线段，头和手为肤色圆
+    Blob            // 只有肤色的头和双手（测试肤色 / 手部检测）
+};
+
+/**
+ * 合成玩家
+ * 位置以帧宽高的比例给出，任意分辨率下运动轨迹相同
+ */
+struct SyntheticPlayer {
+    SyntheticPlayerStyle style{SyntheticPlayerStyle::StickFigure};
+    cv::Point2f center{0.5f, 0.6f};     // 臀部中心（归一化）
+    cv::Point2f sway{0.12f, 0.02f};     // 身体左右 / 上下摆动幅度（归一化）
+    float height{0.6f};                 // 身高占帧高的比例
+    float swayPeriod{4.0f};             // 身体摆动周期（秒）
+    float armPeriod{1.6f};              // 挥臂周期（秒）
+    float phase{0.0f};                  // 相位偏移（弧度）
+    cv::Scalar skinColor{120, 160, 220};    // BGR
+    cv::Scalar bodyColor{200, 80, 40};
+};
+
+/**
+ * 合成玩家在某一时刻的真实关键点（帧像素坐标）
+ * 左右以玩家自身为准：面向摄像头时左手在画面右侧，与姿态检测器输出一致
+ */
+struct SyntheticPose {
+    cv::Point2f head;
+    cv::Point2f leftShoulder;
+    cv::Point2f rightShoulder;
+    cv::Point2f leftElbow;
+    cv::Point2f rightElbow;
+    cv::Point2f leftHand;
+    cv::Point2f rightHand;
+    cv::Point2f hip;
+    cv::Point2f leftKnee;
+    cv::Point2f rightKnee;
+    cv::Point2f leftFoot;
+    cv::Point2f rightFoot;
+};
+
+/**
+ * 合成场景
+ *
+ * 玩家的姿态只是采集时间戳的函数：帧源按帧时间戳绘制，
+ * 下游用同一场景描述和同一时间戳即可得到完全一致的真实位置，无需与采集线程通信。
+ */
+class SyntheticScene {
+public:
+    SyntheticScene() = default;
+    explicit SyntheticScene(std::vector<SyntheticPlayer> players);
+
+    /**
+     * 由场景描述创建：逗号分隔的 figure / blob，如 "figure,blob"；
+     * 空串为两个火柴人。玩家从左到右均匀排开，摆动相位和周期互相错开
+     * @return 描述无效时返回 false
+     */
+    static bool fromSpec(const std::string& spec, SyntheticScene& scene);
+
+    const std::vector<SyntheticPlayer>& getPlayers() const { return m_players; }
+
+    /**
+     * 计算 timestampUs 时刻各玩家的真实关键点
+     * @param timestampUs 采集时间戳（与 CameraFrame::timestampUs 同一时基）
+     * @param frameSize 帧尺寸
+     * @param poses 输出，与 getPlayers() 一一对应（复用缓冲）
+     */
+    void evaluate(int64_t timestampUs, const cv::Size& frameSize, std::vector<SyntheticPose>& poses) const;
+
+    /**
+     * 在 BGR 图像上绘制 evaluate 给出的姿态
+     */
+    void render(const std::vector<SyntheticPose>& poses, cv::Mat& bgr) const;
+
+    /**
+     * 手部位置误差：每个手部坐标到 timestampUs 时刻最近的真实手部的距离的平均值
+     * @param hands 检测到的手部（帧像素坐标）
+     * @return 平均误差（像素）；hands 为空时返回 0
+     */
+    float handError(int64_t timestampUs, const cv::Size& frameSize,
+                    const std::vector<cv::Point2f>& hands) const;
+
+private:
+    std::vector<SyntheticPlayer> m_players;
+    mutable std::vector<SyntheticPose> m_scratch;   // handError 的临时缓冲（仅调用线程使用）
+};
+
+/**
+ * 合成帧源
+ * 以任意分辨率和帧率生成运动的玩家，用于无摄像头的负载 / 延迟测试：
+ * 例如以 120fps 或 4K 驱动整条流水线找出扩展瓶颈，或把检测结果与真实位置比对
+ */
+class SyntheticFrameSource : public FrameSource {
+public:
+    /**
+     * @param scene 场景
+     * @param width 帧宽度
+     * @param height 帧高度
+     * @param fps 帧率（AsFastAsPossible 时不限速）
+     * @param pacing 节奏
+     */
+    SyntheticFrameSource(const SyntheticScene& scene, int width, int height, double fps, PacingMode pacing);
+    ~SyntheticFrameSource() override;
+
+    bool open() override;
+    void close() override;
+    bool read(CameraFrame& frame) override;
+    bool supportsReconfigure() const override { return true; }
+    bool reconfigure(int width, int height, double fps) override;
+
+    int getWidth() const override { return m_width; }
+    int getHeight() const override { return m_height; }
+    double getFps() const override { return m_fps; }
+    std::string getName() const override;
+
+private:
+    // 按当前尺寸生成静态背景
+    void buildBackground();
+
+private:
+    SyntheticScene m_scene;
+    std::vector<SyntheticPose> m_poses;
+    cv::Mat m_background;
+    FramePacer m_pacer;
+    PacingMode m_pacing;
+
+    uint64_t m_frameIndex{0};   // 自上次 open / reconfigure 以来的帧数
+
+    int m_width{0};
+    int m_height{0};
+    double m_fps{30.0};
+};
+
+} // namespace popcorn
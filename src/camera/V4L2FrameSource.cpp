@@ -0,0 +1,375 @@
+#include "V4L2FrameSource.h"
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <linux/videodev2.h>
+
+namespace popcorn {
+
+namespace {
+
+constexpr uint32_t BUFFER_COUNT = 4;
+constexpr int POLL_TIMEOUT_MS = 200;
+
+// ioctl 被信号打断时重试
+int xioctl(int fd, unsigned long request, void* arg) {
+    int r;
+    do {
+        r = ioctl(fd, request, arg);
+    } while (r == -1 && errno == EINTR);
+    return r;
+}
+
+uint32_t toFourcc(CaptureFormat format) {
+    switch (format) {
+        case CaptureFormat::MJPEG: return V4L2_PIX_FMT_MJPEG;
+        case CaptureFormat::NV12:  return V4L2_PIX_FMT_NV12;
+        default:                   return V4L2_PIX_FMT_YUYV;
+    }
+}
+
+const char* formatName(CaptureFormat format) {
+    switch (format) {
+        case CaptureFormat::MJPEG: return "MJPEG";
+        case CaptureFormat::NV12:  return "NV12";
+        default:                   return "YUYV";
+    }
+}
+
+} // namespace
+
+V4L2FrameSource::V4L2FrameSource(const std::string& devicePath, int width, int height,
+                                 double fps, CaptureFormat format, bool keepYuv)
+    : m_devicePath(devicePath)
+    , m_requestedWidth(width)
+    , m_requestedHeight(height)
+    , m_requestedFps(fps)
+    , m_requestedFormat(format)
+    , m_keepYuv(keepYuv) {}
+
+V4L2FrameSource::~V4L2FrameSource() {
+    close();
+}
+
+bool V4L2FrameSource::open() {
+    std::cout << "[V4L2] Opening " << m_devicePath << "...\n";
+
+    m_fd = ::open(m_devicePath.c_str(), O_RDWR | O_NONBLOCK);
+    if (m_fd < 0) {
+        std::cerr << "[V4L2] Failed to open " << m_devicePath << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    // 检查设备能力
+    v4l2_capability cap{};
+    if (xioctl(m_fd, VIDIOC_QUERYCAP, &cap) < 0) {
+        std::cerr << "[V4L2] VIDIOC_QUERYCAP failed: " << std::strerror(errno) << "\n";
+        close();
+        return false;
+    }
+    uint32_t caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS) ? cap.device_caps : cap.capabilities;
+    if (!(caps & V4L2_CAP_VIDEO_CAPTURE) || !(caps & V4L2_CAP_STREAMING)) {
+        std::cerr << "[V4L2] " << m_devicePath << " does not support streaming capture\n";
+        close();
+        return false;
+    }
+
+    // 协商像素格式：Auto 时优先 YUYV（无需解码），其次 MJPEG
+    bool formatOk = false;
+    if (m_requestedFormat == CaptureFormat::Auto) {
+        formatOk = setFormat(CaptureFormat::YUYV) || setFormat(CaptureFormat::MJPEG);
+    } else {
+        formatOk = setFormat(m_requestedFormat);
+    }
+    if (!formatOk) {
+        std::cerr << "[V4L2] No supported pixel format (YUYV/MJPEG/NV12)\n";
+        close();
+        return false;
+    }
+
+    // 设置帧率
+    v4l2_streamparm parm{};
+    parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    parm.parm.capture.timeperframe.numerator = 1;
+    parm.parm.capture.timeperframe.denominator = static_cast<uint32_t>(m_requestedFps);
+    m_fps = m_requestedFps;
+    if (xioctl(m_fd, VIDIOC_S_PARM, &parm) == 0 &&
+        parm.parm.capture.timeperframe.numerator != 0) {
+        m_fps = static_cast<double>(parm.parm.capture.timeperframe.denominator) /
+                parm.parm.capture.timeperframe.numerator;
+    }
+
+    // MJPEG 可以用缩放 IDCT 低成本地得到检测用的小图
+    m_detectionScale = 1;
+    if (m_format == CaptureFormat::MJPEG) {
+        m_detectionScale = MjpegDecoder::chooseScaleDenom(m_width, m_height,
+                                                          m_detectionWidth, m_detectionHeight);
+    }
+
+    if (!initBuffers()) {
+        close();
+        return false;
+    }
+
+    // 开始采集
+    v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (xioctl(m_fd, VIDIOC_STREAMON, &type) < 0) {
+        std::cerr << "[V4L2] VIDIOC_STREAMON failed: " << std::strerror(errno) << "\n";
+        close();
+        return false;
+    }
+    m_streaming = true;
+
+    std::cout << "[V4L2] Streaming " << formatName(m_format) << " "
+              << m_width << "x" << m_height << " @ " << m_fps << "fps ("
+              << m_buffers.size() << " mmap buffers"
+              << (getPixelFormat() != PixelFormat::BGR ? ", GPU color conversion" : "") << ")\n";
+    if (m_detectionScale > 1) {
+        std::cout << "[V4L2] Detection branch: 1/" << m_detectionScale << " scaled MJPEG decode\n";
+    }
+    return true;
+}
+
+PixelFormat V4L2FrameSource::getPixelFormat() const {
+    if (m_keepYuv) {
+        if (m_format == CaptureFormat::YUYV) return PixelFormat::YUYV;
+        if (m_format == CaptureFormat::NV12) return PixelFormat::NV12;
+    }
+    return PixelFormat::BGR;
+}
+
+bool V4L2FrameSource::setFormat(CaptureFormat format) {
+    v4l2_format fmt{};
+    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    fmt.fmt.pix.width = static_cast<uint32_t>(m_requestedWidth);
+    fmt.fmt.pix.height = static_cast<uint32_t>(m_requestedHeight);
+    fmt.fmt.pix.pixelformat = toFourcc(format);
+    fmt.fmt.pix.field = V4L2_FIELD_NONE;
+
+    if (xioctl(m_fd, VIDIOC_S_FMT, &fmt) < 0) {
+        return false;
+    }
+
+    // 驱动可能替换成别的格式，必须确认
+    if (fmt.fmt.pix.pixelformat != toFourcc(format)) {
+        return false;
+    }
+
+    m_format = format;
+    m_width = static_cast<int>(fmt.fmt.pix.width);
+    m_height = static_cast<int>(fmt.fmt.pix.height);
+    m_bytesPerLine = static_cast<int>(fmt.fmt.pix.bytesperline);
+    if (m_bytesPerLine == 0) {
+        m_bytesPerLine = format == CaptureFormat::NV12 ? m_width : m_width * 2;
+    }
+    return true;
+}
+
+bool V4L2FrameSource::initBuffers() {
+    v4l2_requestbuffers req{};
+    req.count = BUFFER_COUNT;
+    req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory = V4L2_MEMORY_MMAP;
+
+    if (xioctl(m_fd, VIDIOC_REQBUFS, &req) < 0 || req.count < 2) {
+        std::cerr << "[V4L2] VIDIOC_REQBUFS failed: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    m_buffers.resize(req.count);
+    for (uint32_t i = 0; i < req.count; ++i) {
+        v4l2_buffer buf{};
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        buf.index = i;
+
+        if (xioctl(m_fd, VIDIOC_QUERYBUF, &buf) < 0) {
+            std::cerr << "[V4L2] VIDIOC_QUERYBUF failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+
+        void* start = mmap(nullptr, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, buf.m.offset);
+        if (start == MAP_FAILED) {
+            std::cerr << "[V4L2] mmap failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        m_buffers[i].start = start;
+        m_buffers[i].length = buf.length;
+
+        if (xioctl(m_fd, VIDIOC_QBUF, &buf) < 0) {
+            std::cerr << "[V4L2] VIDIOC_QBUF failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+void V4L2FrameSource::releaseBuffers() {
+    for (auto& buffer : m_buffers) {
+        if (buffer.start) {
+            munmap(buffer.start, buffer.length);
+        }
+    }
+    m_buffers.clear();
+
+    if (m_fd >= 0) {
+        v4l2_requestbuffers req{};
+        req.count = 0;
+        req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        req.memory = V4L2_MEMORY_MMAP;
+        xioctl(m_fd, VIDIOC_REQBUFS, &req);
+    }
+}
+
+void V4L2FrameSource::close() {
+    if (m_fd < 0) {
+        return;
+    }
+
+    if (m_streaming) {
+        v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        xioctl(m_fd, VIDIOC_STREAMOFF, &type);
+        m_streaming = false;
+    }
+
+    releaseBuffers();
+
+    ::close(m_fd);
+    m_fd = -1;
+}
+
+int V4L2FrameSource::dequeue(uint32_t& bytesUsed, int64_t& timestampUs) {
+    pollfd pfd{};
+    pfd.fd = m_fd;
+    pfd.events = POLLIN;
+
+    int r = poll(&pfd, 1, POLL_TIMEOUT_MS);
+    if (r <= 0) {
+        return -1;
+    }
+
+    v4l2_buffer buf{};
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    if (xioctl(m_fd, VIDIOC_DQBUF, &buf) < 0) {
+        if (errno != EAGAIN) {
+            std::cerr << "[V4L2] VIDIOC_DQBUF failed: " << std::strerror(errno) << "\n";
+        }
+        return -1;
+    }
+
+    int64_t now = nowMicros();
+    bytesUsed = buf.bytesused;
+
+    // 单调时钟时间戳与 steady_clock 同一时基，直接作为采集时间
+    if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC) {
+        timestampUs = static_cast<int64_t>(buf.timestamp.tv_sec) * 1000000 + buf.timestamp.tv_usec;
+        m_lastDequeueLatencyUs = now - timestampUs;
+    } else {
+        timestampUs = now;
+        m_lastDequeueLatencyUs = 0;
+    }
+
+    return static_cast<int>(buf.index);
+}
+
+void V4L2FrameSource::enqueue(int index) {
+    v4l2_buffer buf{};
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = static_cast<uint32_t>(index);
+    if (xioctl(m_fd, VIDIOC_QBUF, &buf) < 0) {
+        std::cerr << "[V4L2] VIDIOC_QBUF failed: " << std::strerror(errno) << "\n";
+    }
+}
+
+bool V4L2FrameSource::read(CameraFrame& frame) {
+    uint32_t bytesUsed = 0;
+    int64_t timestampUs = 0;
+    int index = dequeue(bytesUsed, timestampUs);
+    if (index < 0) {
+        return false;
+    }
+
+    const MappedBuffer& buffer = m_buffers[index];
+    const size_t step = static_cast<size_t>(m_bytesPerLine);
+    PixelFormat pixelFormat = getPixelFormat();
+    bool ok = false;
+
+    if (pixelFormat != PixelFormat::BGR) {
+        // 原样拷入帧池缓冲，颜色转换交给 GPU
+        // 单平面 NV12 的 UV 平面紧跟在 Y 平面之后且行距相同，可视为 1.5 倍高的单通道图
+        cv::Size size = pixelFormatMatSize(pixelFormat, m_width, m_height);
+        cv::Mat yuv(size.height, size.width, pixelFormatMatType(pixelFormat), buffer.start, step);
+        yuv.copyTo(frame.image);
+        ok = true;
+    } else if (m_format == CaptureFormat::YUYV) {
+        // 直接从驱动缓冲转换到帧池缓冲，无中间拷贝
+        cv::Mat yuyv(m_height, m_width, CV_8UC2, buffer.start, step);
+        cv::cvtColor(yuyv, frame.image, cv::COLOR_YUV2BGR_YUYV);
+        ok = true;
+    } else if (m_format == CaptureFormat::NV12) {
+        cv::Mat nv12(m_height * 3 / 2, m_width, CV_8UC1, buffer.start, step);
+        cv::cvtColor(nv12, frame.image, cv::COLOR_YUV2BGR_NV12);
+        ok = true;
+    } else if (bytesUsed > 0) {
+        // MJPEG 直接解码到帧池缓冲，检测分支另做一次缩放解码
+        const uint8_t* jpeg = static_cast<const uint8_t*>(buffer.start);
+        ok = m_decoder.decode(jpeg, bytesUsed, frame.image);
+        if (ok && m_detectionScale > 1 &&
+            !m_decoder.decode(jpeg, bytesUsed, m_reducedImage, m_detectionScale)) {
+            m_reducedImage.release();
+        }
+    }
+
+    enqueue(index);
+
+    if (ok) {
+        frame.format = pixelFormat;
+        frame.timestampUs = timestampUs;
+    }
+    return ok;
+}
+
+bool V4L2FrameSource::reconfigure(int width, int height, double fps) {
+    // S_FMT 要求先停流并释放缓冲，直接整体重新打开设备
+    int previousWidth = m_requestedWidth;
+    int previousHeight = m_requestedHeight;
+    double previousFps = m_requestedFps;
+
+    close();
+    m_requestedWidth = width;
+    m_requestedHeight = height;
+    m_requestedFps = fps;
+    if (open()) {
+        return true;
+    }
+
+    std::cerr << "[V4L2] Failed to switch to " << width << "x" << height << " @ " << fps
+              << "fps, restoring previous mode\n";
+    m_requestedWidth = previousWidth;
+    m_requestedHeight = previousHeight;
+    m_requestedFps = previousFps;
+    open();
+    return false;
+}
+
+bool V4L2FrameSource::skip() {
+    uint32_t bytesUsed = 0;
+    int64_t timestampUs = 0;
+    int index = dequeue(bytesUsed, timestampUs);
+    if (index < 0) {
+        return false;
+    }
+    enqueue(index);
+    return true;
+}
+
+} // namespace popcorn
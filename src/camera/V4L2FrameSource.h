@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "FrameSource.h"
+#include "MjpegDecoder.h"
+
+namespace popcorn {
+
+/**
+ * Linux V4L2 原生采集帧源
+ *
+ * 直接从驱动的 mmap 缓冲出队，不经过 cv::VideoCapture：
+ * - YUYV 一次 cvtColor 直接写入帧池缓冲，MJPEG 直接解码到帧池缓冲
+ * - MJPEG 另做一次 1/2~1/8 的缩放解码，作为生成检测图的输入（见 getReducedImage）
+ * - keepYuv 模式下 YUYV / NV12 原样拷入帧池，由渲染器在着色器中转换，
+ *   省去 CPU 端的颜色转换，上传带宽也降为 RGB 的 2/3（YUYV）或 1/2（NV12）
+ * - 帧时间戳取自 v4l2_buffer（CLOCK_MONOTONIC，与 steady_clock 同一时基），
+ *   可用于统计从曝光到渲染的端到端延迟
+ *
+ * 可使用内核的 vivid 虚拟驱动测试（modprobe vivid），无需真实摄像头
+ */
+class V4L2FrameSource : public FrameSource {
+public:
+    /**
+     * @param devicePath 设备节点（如 /dev/video0）
+     * @param width 期望宽度
+     * @param height 期望高度
+     * @param fps 期望帧率
+     * @param format 期望像素格式
+     * @param keepYuv YUV 格式不转 BGR，原样输出
+     */
+    V4L2FrameSource(const std::string& devicePath, int width, int height, double fps,
+                    CaptureFormat format, bool keepYuv = false);
+    ~V4L2FrameSource() override;
+
+    bool open() override;
+    void close() override;
+    bool read(CameraFrame& frame) override;
+    bool skip() override;
+    bool isLive() const override { return true; }
+    bool supportsReconfigure() const override { return true; }
+    bool reconfigure(int width, int height, double fps) override;
+
+    int getWidth() const override { return m_width; }
+    int getHeight() const override { return m_height; }
+    double getFps() const override { return m_fps; }
+    PixelFormat getPixelFormat() const override;
+    const cv::Mat* getReducedImage() const override {
+        return m_reducedImage.empty() ? nullptr : &m_reducedImage;
+    }
+    std::string getName() const override { return "v4l2:" + m_devicePath; }
+
+    /**
+     * 实际协商到的像素格式
+     */
+    CaptureFormat getFormat() const { return m_format; }
+
+    /**
+     * 最近一帧从驱动时间戳到出队的延迟（微秒）
+     */
+    int64_t getLastDequeueLatencyUs() const { return m_lastDequeueLatencyUs; }
+
+private:
+    struct MappedBuffer {
+        void* start{nullptr};
+        size_t length{0};
+    };
+
+    // 协商格式；失败返回 false
+    bool setFormat(CaptureFormat format);
+
+    // 申请并映射驱动缓冲
+    bool initBuffers();
+
+    // 等待并出队一个缓冲；超时或失败返回 -1
+    int dequeue(uint32_t& bytesUsed, int64_t& timestampUs);
+
+    // 归还缓冲给驱动
+    void enqueue(int index);
+
+    void releaseBuffers();
+
+private:
+    std::string m_devicePath;
+    int m_requestedWidth{0};
+    int m_requestedHeight{0};
+    double m_requestedFps{30.0};
+    CaptureFormat m_requestedFormat{CaptureFormat::Auto};
+    bool m_keepYuv{false};
+
+    int m_fd{-1};
+    bool m_streaming{false};
+    std::vector<MappedBuffer> m_buffers;
+
+    CaptureFormat m_format{CaptureFormat::YUYV};
+    int m_width{0};
+    int m_height{0};
+    int m_bytesPerLine{0};
+    double m_fps{0.0};
+
+    int64_t m_lastDequeueLatencyUs{0};
+
+    MjpegDecoder m_decoder;
+    int m_detectionScale{1};            // 缩放解码的分母，1 表示不生成
+    cv::Mat m_reducedImage;             // 最近一帧的缩放解码结果
+};
+
+} // namespace popcorn
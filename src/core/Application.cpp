@@ -2,23 +2,209 @@
 #include "Window.h"
 #include "Renderer.h"
 #include "camera/CameraCapture.h"
+#include "camera/MultiCameraCapture.h"
 #include "detection/PoseDetector.h"
 #include "detection/GestureDetector.h"
 #include "game/GameEngine.h"
 
 #include <iostream>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
 namespace popcorn {
 
+namespace {
+
+// 把单个摄像头的关键点映射到共享屏幕坐标
+void mapHandToScreen(const MultiCameraCapture& cameras, size_t camera, const cv::Size& frameSize,
+                     HandPosition& hand) {
+    if (!hand.valid) {
+        return;
+    }
+    cv::Point2f screen = cameras.mapToScreen(camera, cv::Point2f(hand.x, hand.y), frameSize);
+    hand.x = screen.x;
+    hand.y = screen.y;
+}
+
+// 对人物的每个关键点执行 fn
+template <typename Fn>
+void forEachKeypoint(DetectedPerson& person, Fn fn) {
+    for (HandPosition* point : {&person.leftHand, &person.rightHand, &person.shoulder, &person.hip,
+                                &person.head, &person.leftShoulder, &person.rightShoulder,
+                                &person.leftElbow, &person.rightElbow}) {
+        fn(*point);
+    }
+}
+
+void mapPersonToScreen(const MultiCameraCapture& cameras, size_t camera, const cv::Size& frameSize,
+                       DetectedPerson& person) {
+    forEachKeypoint(person, [&](HandPosition& point) { mapHandToScreen(cameras, camera, frameSize, point); });
+}
+
+// 处理区域内的坐标平移回整帧坐标
+void offsetPerson(const cv::Point2f& offset, DetectedPerson& person) {
+    forEachKeypoint(person, [&](HandPosition& point) {
+        if (point.valid) {
+            point.x += offset.x;
+            point.y += offset.y;
+        }
+    });
+}
+
+void offsetGesture(const cv::Point2f& offset, HandGestureResult& hand) {
+    if (hand.detected) {
+        hand.x += offset.x;
+        hand.y += offset.y;
+    }
+}
+
+// 单摄像头：关键点从当前采集尺寸换算到参考尺寸（初始采集尺寸），采集档位切换后坐标系不变
+void scalePersons(const cv::Size& frameSize, const cv::Size& targetSize, std::vector<DetectedPerson>& persons) {
+    if (frameSize.width <= 0 || frameSize.height <= 0 || targetSize.width <= 0 || frameSize == targetSize) {
+        return;
+    }
+    const float sx = static_cast<float>(targetSize.width) / frameSize.width;
+    const float sy = static_cast<float>(targetSize.height) / frameSize.height;
+    for (DetectedPerson& person : persons) {
+        forEachKeypoint(person, [&](HandPosition& point) {
+            if (point.valid) {
+                point.x *= sx;
+                point.y *= sy;
+            }
+        });
+    }
+}
+
+void scaleGesture(const cv::Size& frameSize, const cv::Size& targetSize, GestureResult& gesture) {
+    if (frameSize.width <= 0 || frameSize.height <= 0 || targetSize.width <= 0 || frameSize == targetSize) {
+        return;
+    }
+    const float sx = static_cast<float>(targetSize.width) / frameSize.width;
+    const float sy = static_cast<float>(targetSize.height) / frameSize.height;
+    for (HandGestureResult* hand : {&gesture.leftHand, &gesture.rightHand}) {
+        if (hand->detected) {
+            hand->x *= sx;
+            hand->y *= sy;
+        }
+    }
+}
+
+// 检测到的关键点去畸变（帧像素坐标）
+void undistortHand(const LensUndistortion& lens, HandPosition& hand) {
+    if (!hand.valid) {
+        return;
+    }
+    cv::Point2f corrected = lens.undistort(cv::Point2f(hand.x, hand.y));
+    hand.x = corrected.x;
+    hand.y = corrected.y;
+}
+
+void undistortPerson(const LensUndistortion& lens, DetectedPerson& person) {
+    forEachKeypoint(person, [&](HandPosition& point) { undistortHand(lens, point); });
+}
+
+void undistortGesture(const LensUndistortion& lens, HandGestureResult& hand) {
+    if (!hand.detected) {
+        return;
+    }
+    cv::Point2f corrected = lens.undistort(cv::Point2f(hand.x, hand.y));
+    hand.x = corrected.x;
+    hand.y = corrected.y;
+}
+
+// 某摄像头的镜头标定（未标定时为空）
+LensUndistortion* calibratedLens(std::vector<LensUndistortion>& lenses, size_t camera) {
+    return camera < lenses.size() && lenses[camera].isCalibrated() ? &lenses[camera] : nullptr;
+}
+
+// 检测结果从处理区域坐标平移回整帧坐标（去畸变网格和屏幕映射都以整帧为准），
+// 再逐点去畸变：只校正关键点而不是整幅图像，每个点一次网格插值
+void correctPersons(const CameraFrame& frame, LensUndistortion* lens, std::vector<DetectedPerson>& persons) {
+    const cv::Rect region = frame.region();
+    const cv::Point2f offset(static_cast<float>(region.x), static_cast<float>(region.y));
+    const bool cropped = region.x != 0 || region.y != 0;
+    if (lens) {
+        lens->prepare(cv::Size(frame.width(), frame.height()));
+    }
+    for (DetectedPerson& person : persons) {
+        if (cropped) {
+            offsetPerson(offset, person);
+        }
+        if (lens) {
+            undistortPerson(*lens, person);
+        }
+    }
+}
+
+void correctGesture(const CameraFrame& frame, LensUndistortion* lens, GestureResult& gesture) {
+    const cv::Rect region = frame.region();
+    const cv::Point2f offset(static_cast<float>(region.x), static_cast<float>(region.y));
+    if (region.x != 0 || region.y != 0) {
+        offsetGesture(offset, gesture.leftHand);
+        offsetGesture(offset, gesture.rightHand);
+    }
+    if (lens) {
+        lens->prepare(cv::Size(frame.width(), frame.height()));
+        undistortGesture(*lens, gesture.leftHand);
+        undistortGesture(*lens, gesture.rightHand);
+    }
+}
+
+// 多摄像头的手势结果合并：OK 手势优先，其次取置信度更高的
+void mergeGesture(const MultiCameraCapture& cameras, size_t camera, const cv::Size& frameSize,
+                  HandGestureResult hand, HandGestureResult& merged) {
+    if (!hand.detected) {
+        return;
+    }
+    bool better = !merged.detected || (hand.isOkGesture && !merged.isOkGesture) ||
+                  (hand.isOkGesture == merged.isOkGesture && hand.confidence > merged.confidence);
+    if (!better) {
+        return;
+    }
+    cv::Point2f screen = cameras.mapToScreen(camera, cv::Point2f(hand.x, hand.y), frameSize);
+    hand.x = screen.x;
+    hand.y = screen.y;
+    merged = hand;
+}
+
+// 关键点外推上限：覆盖采集加推理的延迟；检测降频时再加上两次检测之间的间隔
+constexpr float BASE_PREDICTION_MS = 100.0f;
+
+// 收集有效的左右手位置
+void collectHands(const std::vector<DetectedPerson>& persons, std::vector<cv::Point2f>& hands) {
+    hands.clear();
+    for (const DetectedPerson& person : persons) {
+        if (person.leftHand.valid) {
+            hands.emplace_back(person.leftHand.x, person.leftHand.y);
+        }
+        if (person.rightHand.valid) {
+            hands.emplace_back(person.rightHand.x, person.rightHand.y);
+        }
+    }
+}
+
+} // namespace
+
 Application::Application() = default;
 
 Application::~Application() {
     shutdown();
 }
 
-bool Application::initialize(int width, int height, const std::string& title) {
+bool Application::initialize(int width, int height, const std::string& title,
+                             const FrameSourceConfig& source) {
+    return initialize(width, height, title, std::vector<FrameSourceConfig>{source});
+}
+
+bool Application::initialize(int width, int height, const std::string& title,
+                             const std::vector<FrameSourceConfig>& sources,
+                             const std::string& homographyPath) {
+    if (sources.empty()) {
+        std::cerr << "[Application] No frame source\n";
+        return false;
+    }
+
     std::cout << "[Application] Initializing...\n";
 
     // 1. 创建窗口
@@ -37,15 +223,8 @@ bool Application::initialize(int width, int height, const std::string& title) {
         return false;
     }
 
-    // 3. 初始化摄像头
-    std::cout << "[Application] Initializing camera...\n";
-    m_camera = std::make_unique<CameraCapture>();
-    if (!m_camera->initialize(0, 1280, 720)) {
-        std::cerr << "[Application] Failed to initialize camera\n";
-        return false;
-    }
-
-    // 4. 初始化姿态检测器 (MoveNet via ONNX Runtime)
+    // 3. 初始化姿态检测器 (MoveNet via ONNX Runtime)
+    //    先于摄像头初始化，以便按模型输入尺寸生成检测图
     std::cout << "[Application] Initializing pose detector...\n";
     m_poseDetector = std::make_unique<PoseDetector>();
     if (!m_poseDetector->initialize("assets/models/movenet_lightning.onnx")) {
@@ -55,6 +234,98 @@ bool Application::initialize(int width, int height, const std::string& title) {
         std::cout << "[Application] Pose detector initialized successfully!\n";
     }
 
+    // 4. 初始化摄像头
+    std::cout << "[Application] Initializing camera...\n";
+    // 采集线程按姿态模型输入尺寸生成检测图（模型未加载时为默认尺寸，手势检测同样使用）
+    std::vector<FrameSourceConfig> sourceConfigs = sources;
+    for (auto& sourceConfig : sourceConfigs) {
+        sourceConfig.detectionWidth = m_poseDetector->getInputWidth();
+        sourceConfig.detectionHeight = m_poseDetector->getInputHeight();
+    }
+    // 镜头标定：检测到的关键点逐个去畸变（网格在首帧按实际分辨率生成）
+    m_lensCorrections.assign(sourceConfigs.size(), LensUndistortion());
+    m_poseTrackers.assign(sourceConfigs.size(), PoseCropTracker());
+    // 检测频率调度：关闭关键点滤波时没有外推填补中间的 tick，不降频
+    DetectionScheduler::Config schedule;
+    schedule.cpuBudget = m_poseFiltering ? m_poseBudget : 1.0f;
+    m_poseScheduler.setConfig(schedule);
+    for (size_t i = 0; i < sourceConfigs.size(); ++i) {
+        const std::string& calibrationPath = sourceConfigs[i].calibrationPath;
+        if (!calibrationPath.empty() && !m_lensCorrections[i].load(calibrationPath)) {
+            std::cerr << "[Application] Failed to load lens calibration\n";
+            return false;
+        }
+    }
+
+    // 会话录制：采集线程逐帧交给录制器，由其写线程落盘
+    std::vector<CameraCapture::FrameListener> listeners;
+    if (!m_recordPath.empty()) {
+        for (size_t i = 0; i < sourceConfigs.size(); ++i) {
+            std::string path = sourceConfigs.size() > 1 ? m_recordPath + ".cam" + std::to_string(i)
+                                                        : m_recordPath;
+            auto recorder = std::make_shared<SessionRecorder>();
+            if (!recorder->open(path, m_recordOptions)) {
+                std::cerr << "[Application] Failed to start recording\n";
+                return false;
+            }
+            // 只持有弱引用：关闭时被放弃的采集线程可能晚于录制器销毁才返回
+            std::weak_ptr<SessionRecorder> target = recorder;
+            listeners.push_back([target](const CameraFrame& frame) {
+                if (std::shared_ptr<SessionRecorder> recorder = target.lock()) {
+                    recorder->submit(frame);
+                }
+            });
+            m_recorders.push_back(std::move(recorder));
+        }
+    }
+
+    // 合成帧源：按同一场景描述构造场景，用于与检测结果比对
+    if (sourceConfigs.size() == 1 && sourceConfigs.front().type == FrameSourceType::Synthetic) {
+        auto scene = std::make_unique<SyntheticScene>();
+        if (SyntheticScene::fromSpec(sourceConfigs.front().path, *scene)) {
+            m_syntheticScene = std::move(scene);
+        }
+    }
+
+    if (sourceConfigs.size() > 1) {
+        // 多摄像头：各自的采集线程并行运行，检测坐标经单应矩阵映射到屏幕空间
+        m_multiCamera = std::make_unique<MultiCameraCapture>();
+        m_multiCamera->setFrameListeners(listeners);
+        if (!m_multiCamera->initialize(sourceConfigs, width, height)) {
+            std::cerr << "[Application] Failed to initialize cameras\n";
+            return false;
+        }
+        if (!homographyPath.empty() && !m_multiCamera->loadHomographies(homographyPath)) {
+            std::cerr << "[Application] Failed to load camera homographies\n";
+            return false;
+        }
+    } else {
+        m_camera = std::make_unique<CameraCapture>();
+        if (!listeners.empty()) {
+            m_camera->setFrameListener(listeners.front());
+        }
+        if (!m_camera->initialize(sourceConfigs.front())) {
+            std::cerr << "[Application] Failed to initialize camera\n";
+            return false;
+        }
+
+        // 姿态检测移到独立线程：主线程每个 tick 只取最新结果，不再等待推理
+        // 检测线程持有自己的去畸变网格副本，与主线程的手势校正互不干扰
+        if (m_asyncPose && m_poseDetector->isInitialized()) {
+            LensUndistortion lens = m_lensCorrections.front();
+            PoseWorker::Correction correction =
+                [lens](const CameraFrame& frame, std::vector<DetectedPerson>& persons) mutable {
+                    correctPersons(frame, lens.isCalibrated() ? &lens : nullptr, persons);
+                };
+            m_poseWorker = std::make_unique<PoseWorker>();
+            if (!m_poseWorker->start(*m_poseDetector, *m_camera, std::move(correction), m_poseSmartCrop,
+                                     m_poseScheduler.getConfig())) {
+                std::cerr << "[Application] Failed to start pose worker, detecting on main thread\n";
+                m_poseWorker.reset();
+            }
+        }
+    }
+
     // 5. 初始化手势检测器 (用于 OK 手势检测)
     std::cout << "[Application] Initializing gesture detector...\n";
     m_gestureDetector = std::make_unique<GestureDetector>();
@@ -73,6 +344,20 @@ bool Application::initialize(int width, int height, const std::string& title) {
         return false;
     }
 
+    // 7. 采集档位调节：以初始协商到的模式为最高档，多摄像头时统一调节
+    //    单摄像头的关键点始终以初始采集尺寸为坐标系（多摄像头由单应矩阵映射到屏幕空间）
+    CameraCapture* primary = m_multiCamera ? &m_multiCamera->getCamera(0) : m_camera.get();
+    if (m_camera) {
+        m_keypointSize = cv::Size(m_camera->getWidth(), m_camera->getHeight());
+    }
+    if (m_adaptiveCapture && primary && primary->supportsReconfigure()) {
+        CaptureGovernor::Config governorConfig;
+        governorConfig.detectionBudgetMs *= static_cast<float>(sourceConfigs.size());
+        m_governor = std::make_unique<CaptureGovernor>();
+        m_governor->initialize(CaptureMode{primary->getWidth(), primary->getHeight(), primary->getFps()},
+                               governorConfig);
+    }
+
     m_running = true;
     m_lastFPSTime = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::steady_clock::now().time_since_epoch()
@@ -96,6 +381,7 @@ void Application::run() {
         auto currentTime = std::chrono::steady_clock::now();
         float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
         lastTime = currentTime;
+        m_maxFrameDelta = std::max(m_maxFrameDelta, deltaTime * 1000.0f);
 
         // 1. 处理事件
         processEvents();
@@ -109,9 +395,19 @@ void Application::run() {
         // 4. 计算 FPS
         calculateFPS();
 
-        // 5. 帧率限制（可选，VSync 通常已处理）
         auto frameEnd = std::chrono::steady_clock::now();
         auto frameDuration = frameEnd - frameStart;
+
+        // 5. 按本 tick 的工作耗时和检测耗时调节采集档位
+        if (m_governor) {
+            CaptureMode mode;
+            float workMs = std::chrono::duration<float, std::milli>(frameDuration).count();
+            if (m_governor->update(workMs, m_tickDetectionTime, mode)) {
+                applyCaptureMode(mode);
+            }
+        }
+
+        // 6. 帧率限制（可选，VSync 通常已处理）
         if (frameDuration < FRAME_DURATION) {
             std::this_thread::sleep_for(FRAME_DURATION - frameDuration);
         }
@@ -130,39 +426,309 @@ void Application::processEvents() {
 }
 
 void Application::update(float deltaTime) {
-    // 1. 获取摄像头帧
-    cv::Mat frame;
-    if (m_camera && m_camera->getFrame(frame)) {
-        std::vector<DetectedPerson> persons;
-        GestureResult gesture;
+    // 1~4. 取帧、检测、更新视频纹理
+    m_tickDetectionTime = -1.0f;
+    if (m_multiCamera) {
+        processFrameSet();
+    } else {
+        processCameraFrame();
+    }
+
+    updateCameraState();
+
+    // 5. 更新游戏逻辑（每个 tick 都推进，无新帧时沿用上一帧的检测结果；摄像头全部断开时暂停）
+    //    关键点滤波开启时，手部位置按估计的速度外推到本 tick，碰撞判定与渲染都使用外推结果
+    if (m_gameEngine && m_lastFrameSequence != 0 && !m_allCamerasLost) {
+        if (m_poseFiltering) {
+            m_poseFilter.predict(nowMicros(), m_predictedPersons);
+            m_gameEngine->update(deltaTime, m_predictedPersons, m_gesture);
+        } else {
+            m_gameEngine->update(deltaTime, m_persons, m_gesture);
+        }
+    }
+
+    // 不循环的文件回放播完后退出（便于脚本化的性能测试）
+    bool finished = m_multiCamera
+        ? m_multiCamera->isFinished()
+        : m_camera && m_camera->isFinished() && m_camera->getLatestSequence() == m_lastFrameSequence;
+    if (finished) {
+        std::cout << "[Application] Frame source finished, quitting\n";
+        m_running = false;
+    }
+}
+
+void Application::updateCameraState() {
+    // 只读原子状态，不阻塞；重新连接在各摄像头的看门狗线程中进行
+    size_t cameraCount = m_multiCamera ? m_multiCamera->getCameraCount() : (m_camera ? 1 : 0);
+    size_t lost = 0;
+    for (size_t i = 0; i < cameraCount; ++i) {
+        CameraCapture& camera = m_multiCamera ? m_multiCamera->getCamera(i) : *m_camera;
+        CaptureState state = camera.getState();
+        if (state == CaptureState::Lost || state == CaptureState::Reconnecting) {
+            ++lost;
+        }
+    }
+
+    bool cameraLost = lost > 0;
+    if (cameraLost != m_cameraLost) {
+        if (cameraLost) {
+            std::cerr << "[Application] Camera lost (" << lost << "/" << cameraCount
+                      << "), reconnecting in background\n";
+        } else {
+            std::cout << "[Application] Camera restored\n";
+        }
+    }
+    m_cameraLost = cameraLost;
+    m_allCamerasLost = cameraCount > 0 && lost == cameraCount;
+}
+
+void Application::processCameraFrame() {
+    // 1. 获取摄像头新帧（计时用于观察交接开销）
+    //    摄像头 30fps、渲染 60Hz，约一半的 tick 没有新帧，此时跳过检测和纹理上传
+    FrameHandle frame;
+    auto acquireStart = std::chrono::steady_clock::now();
+    bool hasNewFrame = m_camera && m_camera->getNewFrame(frame, m_lastFrameSequence);
+    auto acquireEnd = std::chrono::steady_clock::now();
+    m_frameAcquireTime = std::chrono::duration<float, std::micro>(acquireEnd - acquireStart).count();
+    m_maxFrameAcquireTime = std::max(m_maxFrameAcquireTime, m_frameAcquireTime);
+
+    // 异步姿态检测：无论有没有新帧都取检测线程的最新结果，不等待推理
+    if (m_poseWorker) {
+        pollPoseResult();
+    }
+
+    if (!hasNewFrame) {
+        return;
+    }
+
+    m_lastFrameSequence = frame->sequence;
+    m_captureLatency = (nowMicros() - frame->timestampUs) / 1000.0f;
+
+    // 2~3. 姿态检测、手势检测（姿态在检测线程中运行时这里只做手势）
+    //      结果按帧像素坐标输出，再换算到参考尺寸：采集档位切换后游戏和渲染看到的坐标系不变
+    const cv::Size frameSize(frame->width(), frame->height());
+    const bool gestureReady = m_gestureDetector && m_gestureDetector->isInitialized();
+    if (m_poseWorker) {
+        cv::Mat bgr;
+        if (frame->detectionImage.empty()) {
+            bgr = frameToBGR(*frame, m_detectionBGR);
+        }
+        detectGesture(*frame, bgr, 0, m_gesture);
+        if (gestureReady) {
+            scaleGesture(frameSize, m_keypointSize, m_gesture);
+        }
+    } else {
+        // 姿态按调度频率检测；未到检测时刻的帧只做手势，手部位置由关键点滤波外推
+        bool runPose = m_poseScheduler.shouldDetect(frame->timestampUs);
+        float detectionTime = detectFrame(*frame, 0, runPose ? &m_persons : nullptr, m_gesture);
+        if (gestureReady) {
+            scaleGesture(frameSize, m_keypointSize, m_gesture);
+        }
+        if (runPose) {
+            scalePersons(frameSize, m_keypointSize, m_persons);
+            m_detectionTime = detectionTime;
+            m_poseScheduler.onDetection(frame->timestampUs, detectionTime);
+            filterPoseResult(frame->timestampUs, m_poseScheduler.getRateHz());
+            if (m_syntheticScene) {
+                measureCaptureTruth(m_keypointSize, frame->timestampUs);
+            }
+        }
+    }
+
+    // 4. 更新渲染器的视频纹理
+    if (m_renderer) {
+        m_renderer->updateVideoTexture(*frame);
+    }
+}
 
-        // 2. 姿态检测
-        if (m_poseDetector && m_poseDetector->isInitialized()) {
-            auto startTime = std::chrono::steady_clock::now();
+void Application::processFrameSet() {
+    // 1. 获取同步帧组
+    auto acquireStart = std::chrono::steady_clock::now();
+    bool hasNewSet = m_multiCamera->getFrameSet(m_frameSet);
+    auto acquireEnd = std::chrono::steady_clock::now();
+    m_frameAcquireTime = std::chrono::duration<float, std::micro>(acquireEnd - acquireStart).count();
+    m_maxFrameAcquireTime = std::max(m_maxFrameAcquireTime, m_frameAcquireTime);
 
-            persons = m_poseDetector->detect(frame);
+    if (!hasNewSet) {
+        return;
+    }
+
+    m_lastFrameSequence = m_frameSet.id;
+    m_captureLatency = (nowMicros() - m_frameSet.timestampUs) / 1000.0f;
 
-            auto endTime = std::chrono::steady_clock::now();
-            m_detectionTime = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+    // 2~3. 逐个摄像头检测，坐标映射到屏幕空间后合并；人物 id 为摄像头序号
+    //      姿态按调度频率对整组检测，未到检测时刻时保留上一组的结果，只做手势
+    const bool runPose = m_poseScheduler.shouldDetect(m_frameSet.timestampUs);
+    if (runPose) {
+        m_persons.clear();
+    }
+    m_gesture = GestureResult{};
+    float detectionTime = 0.0f;
+    bool textureUpdated = false;
+
+    for (size_t camera = 0; camera < m_frameSet.frames.size(); ++camera) {
+        const FrameHandle& frame = m_frameSet.frames[camera];
+        if (!frame) {
+            continue;
         }
 
-        // 3. 手势检测 (用于 OK 手势启动游戏)
-        if (m_gestureDetector && m_gestureDetector->isInitialized()) {
-            gesture = m_gestureDetector->detect(frame);
+        GestureResult gesture;
+        detectionTime += detectFrame(*frame, camera, runPose ? &m_cameraPersons : nullptr, gesture);
+
+        const cv::Size frameSize(frame->width(), frame->height());
+        if (runPose) {
+            for (DetectedPerson& person : m_cameraPersons) {
+                mapPersonToScreen(*m_multiCamera, camera, frameSize, person);
+                person.id = static_cast<int>(camera);
+                m_persons.push_back(person);
+            }
         }
+        mergeGesture(*m_multiCamera, camera, frameSize, gesture.leftHand, m_gesture.leftHand);
+        mergeGesture(*m_multiCamera, camera, frameSize, gesture.rightHand, m_gesture.rightHand);
 
-        // 4. 更新游戏逻辑
-        if (m_gameEngine) {
-            m_gameEngine->update(deltaTime, persons, gesture);
+        // 4. 视频背景显示组内第一个有帧的摄像头
+        if (!textureUpdated && m_renderer) {
+            m_renderer->updateVideoTexture(*frame);
+            textureUpdated = true;
         }
+    }
 
-        // 5. 更新渲染器的视频纹理
-        if (m_renderer) {
-            m_renderer->updateVideoTexture(frame);
+    if (runPose) {
+        m_detectionTime = detectionTime;
+        m_poseScheduler.onDetection(m_frameSet.timestampUs, detectionTime);
+        filterPoseResult(m_frameSet.timestampUs, m_poseScheduler.getRateHz());
+    }
+}
+
+void Application::applyCaptureMode(const CaptureMode& mode) {
+    // 丢弃滤波历史：切换前后的帧间隔和检测误差不连续，沿用旧速度会外推出虚假的运动
+    m_poseFilter.reset();
+    if (m_multiCamera) {
+        for (size_t i = 0; i < m_multiCamera->getCameraCount(); ++i) {
+            m_multiCamera->getCamera(i).requestCaptureMode(mode.width, mode.height, mode.fps);
         }
+    } else if (m_camera) {
+        m_camera->requestCaptureMode(mode.width, mode.height, mode.fps);
     }
 }
 
+float Application::detectFrame(const CameraFrame& frame, size_t camera,
+                               std::vector<DetectedPerson>* persons, GestureResult& gesture) {
+    // 检测器使用采集线程生成的低分辨率 RGB 图，坐标按处理区域输出；
+    // 没有检测图时退回全分辨率 BGR（YUV 帧转换到复用的缓冲）
+    cv::Mat bgr;
+    if (frame.detectionImage.empty()) {
+        bgr = frameToBGR(frame, m_detectionBGR);
+    }
+
+    float detectionTime = persons ? detectPose(frame, bgr, camera, *persons) : 0.0f;
+    detectGesture(frame, bgr, camera, gesture);
+    return detectionTime;
+}
+
+float Application::detectPose(const CameraFrame& frame, const cv::Mat& bgr, size_t camera,
+                              std::vector<DetectedPerson>& persons) {
+    if (!m_poseDetector || !m_poseDetector->isInitialized()) {
+        persons.clear();
+        return 0.0f;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // 智能裁剪跟踪中且帧本身是 BGR 时改用全分辨率视图，裁剪区域不受检测图分辨率限制
+    PoseCropTracker* tracker = m_poseSmartCrop && camera < m_poseTrackers.size()
+        ? &m_poseTrackers[camera] : nullptr;
+    const bool fullResolution = tracker && tracker->isTracking() && frame.format == PixelFormat::BGR;
+    const cv::Rect region = frame.region();
+    if (bgr.empty() && !fullResolution) {
+        m_poseDetector->detectRGB(frame.detectionImage, region.width, region.height, persons, tracker);
+    } else {
+        m_poseDetector->detect(bgr.empty() ? frameRegion(frame) : bgr, persons, tracker);
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    correctPersons(frame, calibratedLens(m_lensCorrections, camera), persons);
+    float detectionTime = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+
+    // 只有全分辨率路径的耗时随采集档位变化，计入档位调节（多摄像头时累加）
+    if (!bgr.empty() || fullResolution) {
+        m_tickDetectionTime = std::max(m_tickDetectionTime, 0.0f) + detectionTime;
+    }
+    return detectionTime;
+}
+
+void Application::detectGesture(const CameraFrame& frame, const cv::Mat& bgr, size_t camera,
+                                GestureResult& gesture) {
+    // 手势检测 (用于 OK 手势启动游戏)
+    if (!m_gestureDetector || !m_gestureDetector->isInitialized()) {
+        return;
+    }
+
+    const cv::Rect region = frame.region();
+    gesture = bgr.empty()
+        ? m_gestureDetector->detectRGB(frame.detectionImage, region.width, region.height)
+        : m_gestureDetector->detect(bgr);
+    correctGesture(frame, calibratedLens(m_lensCorrections, camera), gesture);
+}
+
+void Application::pollPoseResult() {
+    if (!m_poseWorker->poll(m_poseResult)) {
+        return;
+    }
+
+    // 结果对应的是检测线程取到的那一帧，延迟与误差都按该帧的采集时间戳计算；
+    // 坐标按该帧的尺寸换算到参考尺寸（档位切换前后的结果可能混在一起）
+    m_persons.swap(m_poseResult.persons);
+    scalePersons(m_poseResult.frameSize, m_keypointSize, m_persons);
+    m_detectionTime = m_poseResult.detectionTimeMs;
+    if (m_poseResult.fullResolution) {
+        m_tickDetectionTime = m_detectionTime;
+    }
+    m_poseLag = (nowMicros() - m_poseResult.timestampUs) / 1000.0f;
+    filterPoseResult(m_poseResult.timestampUs, m_poseWorker->getStats().rateHz);
+    if (m_syntheticScene) {
+        measureCaptureTruth(m_keypointSize, m_poseResult.timestampUs);
+    }
+}
+
+void Application::filterPoseResult(int64_t timestampUs, float rateHz) {
+    if (!m_poseFiltering) {
+        return;
+    }
+    m_poseFilter.update(m_persons, timestampUs);
+    m_poseFilter.setMaxPredictionMs(BASE_PREDICTION_MS + (rateHz > 0.0f ? 1000.0f / rateHz : 0.0f));
+}
+
+void Application::measureCaptureTruth(const cv::Size& frameSize, int64_t timestampUs) {
+    collectHands(m_persons, m_truthHands);
+    m_truthFrameSize = frameSize;
+    m_truthTimestampUs = timestampUs;
+    m_truthDisplayPending = true;
+
+    if (!m_truthHands.empty()) {
+        m_truthCaptureError += m_syntheticScene->handError(m_truthTimestampUs, m_truthFrameSize, m_truthHands);
+        ++m_truthCaptureSamples;
+    }
+}
+
+void Application::measureDisplayTruth() {
+    // 缓冲交换之后：这一帧的检测结果此刻才出现在屏幕上，玩家已经移动到新位置
+    int64_t displayUs = nowMicros();
+    m_truthDisplayLatency += (displayUs - m_truthTimestampUs) / 1000.0f;
+    ++m_truthLatencySamples;
+    // 关键点滤波开启时屏幕上画的是外推后的手，显示误差按外推结果计算
+    const std::vector<cv::Point2f>* hands = &m_truthHands;
+    if (m_poseFiltering) {
+        collectHands(m_predictedPersons, m_displayHands);
+        hands = &m_displayHands;
+    }
+    if (!hands->empty()) {
+        m_truthDisplayError += m_syntheticScene->handError(displayUs, m_truthFrameSize, *hands);
+        ++m_truthErrorSamples;
+    }
+    m_truthDisplayPending = false;
+}
+
 void Application::render() {
     if (!m_renderer || !m_window) return;
 
@@ -197,10 +763,19 @@ void Application::render() {
         );
     }
 
+    // 摄像头断开：画面停在最后一帧，叠加提示直到重新连接
+    if (m_cameraLost) {
+        m_renderer->renderGameStateHint("camera lost");
+    }
+
     m_renderer->endFrame();
 
     // 交换缓冲区
     m_window->swapBuffers();
+
+    if (m_syntheticScene && m_truthDisplayPending) {
+        measureDisplayTruth();
+    }
 }
 
 void Application::calculateFPS() {
@@ -217,7 +792,90 @@ void Application::calculateFPS() {
 
         // 每秒输出一次性能信息
         std::cout << "[Performance] FPS: " << m_fps
-                  << " | Detection: " << m_detectionTime << "ms\n";
+                  << " | MaxFrame: " << m_maxFrameDelta << "ms"
+                  << " | Detection: " << m_detectionTime << "ms"
+                  << " | CaptureLatency: " << m_captureLatency << "ms"
+                  << " | FrameAcquire: " << m_frameAcquireTime << "us (max "
+                  << m_maxFrameAcquireTime << "us)";
+        if (m_poseWorker) {
+            // 检测线程：结果滞后（采集到被取走）与来不及检测而跳过的帧
+            auto poseStats = m_poseWorker->getStats();
+            std::cout << " | PoseLag: " << m_poseLag << "ms"
+                      << " | PoseFrames: " << poseStats.framesDetected - m_lastPoseStats.framesDetected
+                      << " (skipped " << poseStats.framesSkipped - m_lastPoseStats.framesSkipped
+                      << ", throttled " << poseStats.framesThrottled - m_lastPoseStats.framesThrottled << ")";
+            if (poseStats.rateHz > 0.0f) {
+                std::cout << " | PoseRate: " << poseStats.rateHz << "Hz";
+            }
+            m_lastPoseStats = poseStats;
+        } else if (m_poseScheduler.isThrottling()) {
+            std::cout << " | PoseRate: " << m_poseScheduler.getRateHz() << "Hz";
+        }
+        if (m_cameraLost) {
+            std::cout << " | Camera: lost";
+        }
+        if (m_governor) {
+            std::cout << " | CaptureMode: " << m_governor->getMode().toString()
+                      << " (level " << m_governor->getLevel() << ")";
+        }
+        if (m_camera) {
+            // 帧池重新分配计数：稳态下应保持为 0
+            auto bufferStats = m_camera->getBufferStats();
+            std::cout << " | CamBufAllocs: " << bufferStats.allocations
+                      << " (realloc " << bufferStats.reallocations
+                      << ", exhausted " << bufferStats.exhausted
+                      << ", zero-copy " << bufferStats.zeroCopy << ")";
+
+            // 本周期的采集遥测，与 MaxFrame 对照判断卡顿是否来自摄像头
+            auto captureStats = m_camera->getCaptureStats();
+            auto window = captureStats.since(m_lastCaptureStats);
+            m_lastCaptureStats = captureStats;
+            std::cout << "\n[Capture] Frames: " << window.framesCaptured
+                      << " | Interval p50/p99/max: " << window.intervalUs.percentileUs(50) / 1000.0f
+                      << "/" << window.intervalUs.percentileUs(99) / 1000.0f
+                      << "/" << window.intervalUs.maxUs / 1000.0f << "ms"
+                      << " | Jitter p99: " << window.jitterUs.percentileUs(99) / 1000.0f << "ms"
+                      << " | ReadBlock p99/max: " << window.readBlockUs.percentileUs(99) / 1000.0f
+                      << "/" << window.readBlockUs.maxUs / 1000.0f << "ms"
+                      << " | Dropped: " << window.droppedUnconsumed << " unconsumed, "
+                      << window.droppedPoolFull << " pool full"
+                      << " | ReadFails: " << window.failedReads
+                      << " | Reconnects: " << m_camera->getReconnectCount();
+        }
+        if (m_multiCamera) {
+            auto syncStats = m_multiCamera->getSyncStats();
+            std::cout << " | Cameras: " << m_multiCamera->getCameraCount()
+                      << " | Sets: " << syncStats.completeSets << " synced, "
+                      << syncStats.partialSets << " partial, "
+                      << syncStats.unmatchedFrames << " unmatched frames"
+                      << " | Spread: " << m_frameSet.spreadUs / 1000.0f << "ms";
+        }
+        for (const auto& recorder : m_recorders) {
+            auto recordStats = recorder->getStats();
+            std::cout << " | Recorded: " << recordStats.framesWritten << " frames, "
+                      << recordStats.bytesWritten / (1024 * 1024) << "MB ("
+                      << recordStats.framesDropped << " dropped)";
+        }
+        if (m_syntheticScene && m_truthLatencySamples > 0) {
+            // 采集时刻的误差反映检测精度，显示时刻的误差再加上采集到显示期间玩家的移动
+            // 两者的样本数不同：检测结果可能未显示就被下一次检测取代，显示时的手也可能来自外推
+            float captureSamples = static_cast<float>(std::max(m_truthCaptureSamples, 1));
+            float displaySamples = static_cast<float>(std::max(m_truthErrorSamples, 1));
+            std::cout << "\n[Synthetic] HandError capture/display: "
+                      << m_truthCaptureError / captureSamples << "/"
+                      << m_truthDisplayError / displaySamples << "px"
+                      << " | CaptureToDisplay: " << m_truthDisplayLatency / m_truthLatencySamples << "ms"
+                      << " | Frames: " << m_truthLatencySamples << " (" << m_truthErrorSamples << " with hands)";
+            m_truthCaptureError = 0.0f;
+            m_truthDisplayError = 0.0f;
+            m_truthDisplayLatency = 0.0f;
+            m_truthCaptureSamples = 0;
+            m_truthErrorSamples = 0;
+            m_truthLatencySamples = 0;
+        }
+        std::cout << "\n";
+        m_maxFrameAcquireTime = 0.0f;
+        m_maxFrameDelta = 0.0f;
     }
 }
 
@@ -226,10 +884,15 @@ void Application::shutdown() {
 
     m_running = false;
 
+    m_governor.reset();
     m_gameEngine.reset();
+    m_poseWorker.reset();
     m_gestureDetector.reset();
     m_poseDetector.reset();
+    m_frameSet.frames.clear();
+    m_multiCamera.reset();
     m_camera.reset();
+    m_recorders.clear();
     m_renderer.reset();
     m_window.reset();
 
@@ -3,6 +3,21 @@
 #include <memory>
 #include <string>
 #include <atomic>
+#include <vector>
+#include <cstdint>
+#include "camera/CaptureGovernor.h"
+#include "camera/CaptureStats.h"
+#include "camera/FrameSource.h"
+#include "camera/LensUndistortion.h"
+#include "camera/MultiCameraCapture.h"
+#include "camera/SessionRecorder.h"
+#include "camera/SyntheticFrameSource.h"
+#include "detection/DetectionScheduler.h"
+#include "detection/KeypointFilter.h"
+#include "detection/PoseCropTracker.h"
+#include "detection/PoseDetector.h"
+#include "detection/PoseWorker.h"
+#include "detection/GestureDetector.h"
 
 namespace popcorn {
 
@@ -10,6 +25,7 @@ namespace popcorn {
 class Window;
 class Renderer;
 class CameraCapture;
+class MultiCameraCapture;
 class PoseDetector;
 class GestureDetector;
 class GameEngine;
@@ -32,9 +48,66 @@ public:
      * @param width 窗口宽度
      * @param height 窗口高度
      * @param title 窗口标题
+     * @param source 帧源配置（默认使用 0 号摄像头）
      * @return 成功返回 true
      */
-    bool initialize(int width, int height, const std::string& title);
+    bool initialize(int width, int height, const std::string& title,
+                    const FrameSourceConfig& source = FrameSourceConfig{});
+
+    /**
+     * 以多个帧源初始化（两个及以上时启用多摄像头同步采集）
+     * @param width 窗口宽度
+     * @param height 窗口高度
+     * @param title 窗口标题
+     * @param sources 每个摄像头的帧源配置
+     * @param homographyPath 各摄像头到屏幕坐标的单应矩阵文件（空表示并排默认布局）
+     * @return 成功返回 true
+     */
+    bool initialize(int width, int height, const std::string& title,
+                    const std::vector<FrameSourceConfig>& sources,
+                    const std::string& homographyPath = "");
+
+    /**
+     * 是否按负载自动调节采集分辨率和帧率（需在 initialize 之前调用，默认开启）
+     * 仅对支持运行时切换的帧源（摄像头、V4L2）生效
+     */
+    void setAdaptiveCapture(bool enabled) { m_adaptiveCapture = enabled; }
+
+    /**
+     * 是否在独立线程中运行姿态检测（需在 initialize 之前调用，默认开启）
+     * 开启时主线程不再等待推理，每个 tick 只取检测线程发布的最新结果；
+     * 仅单摄像头生效，多摄像头按同步帧组在主线程检测
+     */
+    void setAsyncPose(bool enabled) { m_asyncPose = enabled; }
+
+    /**
+     * 是否启用 MoveNet 智能裁剪（需在 initialize 之前调用，默认开启）
+     * 开启时按上一帧的关键点只检测人物周围的区域，跟丢时退回整帧；每个摄像头各自跟踪
+     */
+    void setPoseSmartCrop(bool enabled) { m_poseSmartCrop = enabled; }
+
+    /**
+     * 是否对关键点做 One Euro 滤波并外推到当前时刻（需在 initialize 之前调用，默认开启）
+     * 开启时游戏逻辑与渲染使用外推到本 tick 的手部位置，而不是源帧采集时刻的原始检测结果
+     */
+    void setPoseFiltering(bool enabled) { m_poseFiltering = enabled; }
+
+    /**
+     * 姿态推理可占用的 CPU 时间比例（需在 initialize 之前调用，默认 0.5；1 表示每帧都检测）
+     * 推理较慢时按该预算降低检测频率，中间的 tick 由关键点滤波外推；关闭关键点滤波时不降频
+     */
+    void setPoseBudget(float budget) { m_poseBudget = budget; }
+
+    /**
+     * 录制采集到的每一帧（需在 initialize 之前调用）
+     * 多摄像头时每个摄像头录制到 path + ".cam<序号>"
+     * @param path 会话数据文件路径
+     * @param options 录制选项
+     */
+    void setRecording(const std::string& path, const SessionRecorder::Options& options) {
+        m_recordPath = path;
+        m_recordOptions = options;
+    }
 
     /**
      * 运行主循环
@@ -61,6 +134,11 @@ public:
      */
     float getDetectionTime() const { return m_detectionTime; }
 
+    /**
+     * 获取取帧耗时（微秒）
+     */
+    float getFrameAcquireTime() const { return m_frameAcquireTime; }
+
 private:
     // 处理输入事件
     void processEvents();
@@ -74,17 +152,101 @@ private:
     // 计算 FPS
     void calculateFPS();
 
+    // 单摄像头：取新帧并检测
+    void processCameraFrame();
+
+    // 多摄像头：取同步帧组，逐个检测后映射到屏幕坐标并合并
+    void processFrameSet();
+
+    // 检查摄像头是否断开（看门狗判定），状态变化时输出日志
+    void updateCameraState();
+
+    // 把调节器选出的采集模式交给所有摄像头
+    void applyCaptureMode(const CaptureMode& mode);
+
+    // 在一帧上运行姿态和手势检测（关键点按该摄像头的标定去畸变），返回姿态检测耗时（毫秒）
+    // persons 为空时只做手势检测（姿态未到调度的检测时刻）
+    float detectFrame(const CameraFrame& frame, size_t camera, std::vector<DetectedPerson>* persons,
+                      GestureResult& gesture);
+
+    // 姿态 / 手势检测；bgr 为没有检测图时的整帧 BGR（有检测图时为空）
+    float detectPose(const CameraFrame& frame, const cv::Mat& bgr, size_t camera,
+                     std::vector<DetectedPerson>& persons);
+    void detectGesture(const CameraFrame& frame, const cv::Mat& bgr, size_t camera, GestureResult& gesture);
+
+    // 取检测线程发布的最新姿态结果
+    void pollPoseResult();
+
+    // 新的姿态结果交给关键点滤波（timestampUs 为源帧采集时间戳，rateHz 为当前检测频率上限）
+    void filterPoseResult(int64_t timestampUs, float rateHz);
+
+    // 合成帧源：把检测到的手与采集时刻、显示时刻的真实位置比对
+    void measureCaptureTruth(const cv::Size& frameSize, int64_t timestampUs);
+    void measureDisplayTruth();
+
 private:
     std::unique_ptr<Window> m_window;
     std::unique_ptr<Renderer> m_renderer;
     std::unique_ptr<CameraCapture> m_camera;
+    std::unique_ptr<MultiCameraCapture> m_multiCamera;   // 两个及以上帧源时代替 m_camera
     std::unique_ptr<PoseDetector> m_poseDetector;
+    std::unique_ptr<PoseWorker> m_poseWorker;       // 异步姿态检测（未启用时为空）
     std::unique_ptr<GestureDetector> m_gestureDetector;
     std::unique_ptr<GameEngine> m_gameEngine;
+    std::unique_ptr<CaptureGovernor> m_governor;    // 帧源不支持运行时切换时为空
+    std::vector<LensUndistortion> m_lensCorrections;    // 每个摄像头一个（未标定的不校正）
+    std::vector<PoseCropTracker> m_poseTrackers;        // 主线程检测时每个摄像头一个
+    bool m_cameraLost{false};           // 有摄像头断开、正在后台重新连接
+    bool m_allCamerasLost{false};       // 所有摄像头都断开（暂停游戏）
+    bool m_adaptiveCapture{true};
+    bool m_asyncPose{true};
+    bool m_poseSmartCrop{true};
+    bool m_poseFiltering{true};
+    float m_poseBudget{0.5f};
+
+    // 会话录制（每个摄像头一个；须在摄像头之后销毁）
+    std::string m_recordPath;
+    SessionRecorder::Options m_recordOptions;
+    std::vector<std::shared_ptr<SessionRecorder>> m_recorders;
 
     std::atomic<bool> m_running{false};
     float m_fps{0.0f};
     float m_detectionTime{0.0f};
+    float m_tickDetectionTime{-1.0f};   // 本 tick 在全分辨率帧上的检测耗时（没有为负），交给采集档位调节
+    float m_frameAcquireTime{0.0f};     // 取帧耗时（微秒）
+    float m_maxFrameAcquireTime{0.0f};  // 本统计周期内最大取帧耗时（微秒）
+    float m_captureLatency{0.0f};       // 采集时间戳到主线程处理的延迟（毫秒）
+    float m_maxFrameDelta{0.0f};        // 本统计周期内最大主循环帧间隔（毫秒）
+    CaptureStats::Snapshot m_lastCaptureStats;  // 上一统计周期末的采集遥测
+
+    // 最近一次处理的摄像头帧（多摄像头时为帧组序号）及其检测结果（重复帧直接复用）
+    uint64_t m_lastFrameSequence{0};
+    FrameSet m_frameSet;                // 多摄像头当前帧组（复用缓冲）
+    std::vector<DetectedPerson> m_cameraPersons;    // 单个摄像头的检测结果（复用缓冲）
+    std::vector<DetectedPerson> m_persons;
+    cv::Size m_keypointSize;                        // 单摄像头关键点的参考尺寸（初始采集尺寸）
+    PoseFilter m_poseFilter;                        // 关键点滤波（按源帧采集时间推进）
+    DetectionScheduler m_poseScheduler;             // 主线程检测时的检测频率调度
+    std::vector<DetectedPerson> m_predictedPersons; // 外推到本 tick 的人物（交给游戏逻辑）
+    GestureResult m_gesture;
+    PoseResult m_poseResult;            // 最近取到的异步姿态结果（复用缓冲）
+    float m_poseLag{0.0f};              // 最近结果的源帧采集到被主线程取走的延迟（毫秒）
+    PoseWorker::Stats m_lastPoseStats;  // 上一统计周期末的检测线程统计
+    cv::Mat m_detectionBGR;             // YUV 帧转给检测器的 BGR 缓冲
+
+    // 合成帧源的真实位置（单摄像头合成帧源时非空），场景与帧源按同一描述构造
+    std::unique_ptr<SyntheticScene> m_syntheticScene;
+    std::vector<cv::Point2f> m_truthHands;  // 最近一帧检测到的手（帧像素坐标）
+    std::vector<cv::Point2f> m_displayHands;    // 显示时刻画出的手（关键点滤波开启时为外推结果）
+    cv::Size m_truthFrameSize;
+    int64_t m_truthTimestampUs{0};          // 最近一帧的采集时间戳
+    bool m_truthDisplayPending{false};      // 最近一帧的检测结果尚未显示
+    float m_truthCaptureError{0.0f};        // 本统计周期累计：与采集时刻真实位置的误差（像素）
+    float m_truthDisplayError{0.0f};        // 本统计周期累计：与显示时刻真实位置的误差（像素）
+    float m_truthDisplayLatency{0.0f};      // 本统计周期累计：采集到显示的延迟（毫秒）
+    int m_truthCaptureSamples{0};           // 计入采集时刻误差的检测次数
+    int m_truthErrorSamples{0};             // 计入显示时刻误差的显示次数
+    int m_truthLatencySamples{0};
 
     // 帧率计算
     uint64_t m_frameCount{0};
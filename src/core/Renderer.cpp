@@ -1,5 +1,6 @@
 #include "Renderer.h"
 #include "render/ParticleSystem.h"
+#include "camera/CameraFrame.h"
 
 // Windows MSVC 需要此宏才能使用 M_PI
 #define _USE_MATH_DEFINES
@@ -99,6 +100,11 @@ void Renderer::shutdown() {
         glDeleteTextures(1, &m_videoTexture);
         m_videoTexture = 0;
     }
+    if (m_videoTextureUV) {
+        glDeleteTextures(1, &m_videoTextureUV);
+        m_videoTextureUV = 0;
+    }
+    m_videoFormat = -1;
     if (m_shaderProgram) {
         glDeleteProgram(m_shaderProgram);
         m_shaderProgram = 0;
@@ -148,17 +154,49 @@ bool Renderer::initShaders() {
     )";
 
     // 片段着色器
+    // uFormat 与 PixelFormat 的取值一致：
+    //   0 = BGR（上传时由驱动交换通道）
+    //   1 = YUYV（RGBA 纹理，宽度减半，每个纹素为 Y0 U Y1 V）
+    //   2 = NV12（uTexture 为 Y 平面，uTextureUV 为半分辨率 UV 平面）
     const char* fragmentShaderSource = R"(
         #version 410 core
         in vec2 TexCoord;
         out vec4 FragColor;
         uniform sampler2D uTexture;
+        uniform sampler2D uTextureUV;
+        uniform int uFormat;
+        uniform vec2 uVideoSize;
         uniform float uFlash;
+
+        // BT.601 有限范围（摄像头常用）
+        vec3 yuvToRgb(float y, float u, float v) {
+            y = 1.1644 * (y - 0.0625);
+            u -= 0.5;
+            v -= 0.5;
+            return vec3(y + 1.5960 * v,
+                        y - 0.3918 * u - 0.8130 * v,
+                        y + 2.0172 * u);
+        }
+
         void main() {
-            vec4 color = texture(uTexture, TexCoord);
+            vec3 rgb;
+            if (uFormat == 1) {
+                // 一个纹素包含两个像素，按像素坐标取对应的 Y
+                ivec2 p = clamp(ivec2(TexCoord * uVideoSize), ivec2(0), ivec2(uVideoSize) - 1);
+                vec4 t = texelFetch(uTexture, ivec2(p.x / 2, p.y), 0);
+                float y = (p.x % 2 == 0) ? t.r : t.b;
+                rgb = yuvToRgb(y, t.g, t.a);
+            } else if (uFormat == 2) {
+                float y = texture(uTexture, TexCoord).r;
+                vec2 uv = texture(uTextureUV, TexCoord).rg;
+                rgb = yuvToRgb(y, uv.x, uv.y);
+            } else {
+                rgb = texture(uTexture, TexCoord).rgb;
+            }
+            rgb = clamp(rgb, 0.0, 1.0);
             // 添加闪光效果
-            color.rgb = mix(color.rgb, vec3(1.0), uFlash);
-            FragColor = color;
+            rgb = mix(rgb, vec3(1.0), uFlash);
+            FragColor = vec4(rgb, 1.0);
         }
     )";
 
@@ -206,25 +244,19 @@ bool Renderer::initShaders() {
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
-    // 创建全屏四边形顶点数据
-    // 位置 (x, y) + 纹理坐标 (u, v)
-    float vertices[] = {
-        // 位置          // 纹理坐标（翻转 Y 轴，镜像 X 轴）
-        -1.0f,  1.0f,   1.0f, 0.0f,  // 左上
-        -1.0f, -1.0f,   1.0f, 1.0f,  // 左下
-         1.0f, -1.0f,   0.0f, 1.0f,  // 右下
-
-        -1.0f,  1.0f,   1.0f, 0.0f,  // 左上
-         1.0f, -1.0f,   0.0f, 1.0f,  // 右下
-         1.0f,  1.0f,   0.0f, 0.0f,  // 右上
-    };
+    // 纹理单元：0 = 主纹理，1 = NV12 的 UV 平面
+    glUseProgram(m_shaderProgram);
+    glUniform1i(glGetUniformLocation(m_shaderProgram, "uTexture"), 0);
+    glUniform1i(glGetUniformLocation(m_shaderProgram, "uTextureUV"), 1);
+    glUseProgram(0);
 
+    // 创建视频四边形：位置 (x, y) + 纹理坐标 (u, v)，顶点随处理区域更新（见 updateVideoQuad）
     glGenVertexArrays(1, &m_vao);
     glGenBuffers(1, &m_vbo);
 
     glBindVertexArray(m_vao);
     glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, 24 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
 
     // 位置属性
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
@@ -235,18 +267,51 @@ bool Renderer::initShaders() {
 
     glBindVertexArray(0);
 
+    updateVideoQuad(cv::Rect2f(0.0f, 0.0f, 1.0f, 1.0f));
+
     return true;
 }
 
+void Renderer::updateVideoQuad(const cv::Rect2f& area) {
+    // 纹理只包含处理区域，四边形摆在该区域在屏幕上的位置，关键点与画面保持对齐；
+    // 画面镜像显示：区域的 [x0, x1] 出现在屏幕的 [1 - x1, 1 - x0]，区域外保持清屏色
+    float left = 1.0f - 2.0f * (area.x + area.width);
+    float right = 1.0f - 2.0f * area.x;
+    float top = 1.0f - 2.0f * area.y;
+    float bottom = 1.0f - 2.0f * (area.y + area.height);
+
+    float vertices[] = {
+        // 位置          // 纹理坐标（翻转 Y 轴，镜像 X 轴）
+        left,  top,      1.0f, 0.0f,  // 左上
+        left,  bottom,   1.0f, 1.0f,  // 左下
+        right, bottom,   0.0f, 1.0f,  // 右下
+
+        left,  top,      1.0f, 0.0f,  // 左上
+        right, bottom,   0.0f, 1.0f,  // 右下
+        right, top,      0.0f, 0.0f,  // 右上
+    };
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_videoArea = area;
+}
+
 bool Renderer::initVideoTexture() {
-    glGenTextures(1, &m_videoTexture);
-    glBindTexture(GL_TEXTURE_2D, m_videoTexture);
+    uint32_t textures[2];
+    glGenTextures(2, textures);
+    m_videoTexture = textures[0];
+    m_videoTextureUV = textures[1];
+
+    for (uint32_t texture : textures) {
+        glBindTexture(GL_TEXTURE_2D, texture);
 
-    // 设置纹理参数
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        // 设置纹理参数
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
 
     glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -445,20 +510,79 @@ void Renderer::endFrame() {
     // 帧结束处理
 }
 
+void Renderer::uploadVideoPlane(uint32_t texture, int internalFormat, uint32_t format,
+                                int width, int height, const cv::Mat& plane, bool needRealloc) {
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    // 按 Mat 的实际行距读取，非连续的 Mat 也无需先拷贝
+    size_t texelBytes = plane.elemSize() * plane.cols / width;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<int>(plane.step[0] / texelBytes));
+
+    // 尺寸和格式不变时只更新内容，不重新分配纹理存储
+    if (needRealloc) {
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0,
+                     format, GL_UNSIGNED_BYTE, plane.data);
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height,
+                        format, GL_UNSIGNED_BYTE, plane.data);
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 void Renderer::updateVideoTexture(const cv::Mat& frame) {
     if (frame.empty()) return;
 
-    glBindTexture(GL_TEXTURE_2D, m_videoTexture);
+    CameraFrame bgr;
+    bgr.image = frame;
+    bgr.format = PixelFormat::BGR;
+    updateVideoTexture(bgr);
+}
 
-    // OpenCV 默认是 BGR，转换为 RGB
-    cv::Mat rgbFrame;
-    cv::cvtColor(frame, rgbFrame, cv::COLOR_BGR2RGB);
+void Renderer::updateVideoTexture(const CameraFrame& frame) {
+    if (frame.image.empty()) return;
+
+    // 只上传处理区域（按行距读取，无需先拷贝）
+    const cv::Rect region = frame.region();
+    int width = region.width;
+    int height = region.height;
+    int format = static_cast<int>(frame.format);
+    bool needRealloc = format != m_videoFormat || width != m_videoWidth || height != m_videoHeight;
+
+    cv::Rect2f area(static_cast<float>(region.x) / frame.width(), static_cast<float>(region.y) / frame.height(),
+                    static_cast<float>(width) / frame.width(), static_cast<float>(height) / frame.height());
+    if (area != m_videoArea) {
+        updateVideoQuad(area);
+    }
+
+    switch (frame.format) {
+        case PixelFormat::YUYV:
+            // 每个 RGBA 纹素打包两个像素（Y0 U Y1 V），在着色器中展开
+            uploadVideoPlane(m_videoTexture, GL_RGBA8, GL_RGBA, width / 2, height, frameRegion(frame), needRealloc);
+            break;
+
+        case PixelFormat::NV12: {
+            // Y 平面 + 半分辨率的交错 UV 平面
+            cv::Mat planeY;
+            cv::Mat planeUV;
+            frameRegionNV12(frame, planeY, planeUV);
+            uploadVideoPlane(m_videoTexture, GL_R8, GL_RED, width, height, planeY, needRealloc);
+            uploadVideoPlane(m_videoTextureUV, GL_RG8, GL_RG, width / 2, height / 2, planeUV, needRealloc);
+            break;
+        }
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB,
-                 rgbFrame.cols, rgbFrame.rows, 0,
-                 GL_RGB, GL_UNSIGNED_BYTE, rgbFrame.data);
+        default:
+            // OpenCV 默认是 BGR，由驱动在上传时交换通道，无需 CPU 转换
+            uploadVideoPlane(m_videoTexture, GL_RGB8, GL_BGR, width, height, frameRegion(frame), needRealloc);
+            break;
+    }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    m_videoFormat = format;
+    m_videoWidth = width;
+    m_videoHeight = height;
 }
 
 void Renderer::renderVideoBackground() {
@@ -472,6 +596,17 @@ void Renderer::renderVideoBackground() {
     // 设置闪光强度
     glUniform1f(glGetUniformLocation(m_shaderProgram, "uFlash"), m_flashIntensity);
 
+    // 像素格式与视频尺寸（YUV 转换用）
+    bool isNV12 = m_videoFormat == static_cast<int>(PixelFormat::NV12);
+    glUniform1i(glGetUniformLocation(m_shaderProgram, "uFormat"), m_videoFormat < 0 ? 0 : m_videoFormat);
+    glUniform2f(glGetUniformLocation(m_shaderProgram, "uVideoSize"),
+                static_cast<float>(m_videoWidth), static_cast<float>(m_videoHeight));
+
+    if (isNV12) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, m_videoTextureUV);
+        glActiveTexture(GL_TEXTURE0);
+    }
     glBindTexture(GL_TEXTURE_2D, m_videoTexture);
     glBindVertexArray(m_vao);
 
@@ -479,6 +614,11 @@ void Renderer::renderVideoBackground() {
 
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
+    if (isNV12) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glActiveTexture(GL_TEXTURE0);
+    }
 }
 
 void Renderer::renderZones() {
@@ -16,6 +16,7 @@ namespace popcorn {
 
 // 前向声明
 class ParticleSystem;
+struct CameraFrame;
 
 /**
  * 分数弹出动画
@@ -42,9 +43,12 @@ public:
     void beginFrame();
     void endFrame();
 
-    // 更新视频纹理
+    // 更新视频纹理（BGR 图像）
     void updateVideoTexture(const cv::Mat& frame);
 
+    // 更新视频纹理（按帧的像素格式上传，YUV 在着色器中转换）
+    void updateVideoTexture(const CameraFrame& frame);
+
     // 渲染视频背景
     void renderVideoBackground();
 
@@ -92,6 +96,13 @@ private:
     bool initCircleGeometry();
     bool initRectGeometry();
 
+    // 按视频纹理覆盖的画面区域（归一化，即处理区域）更新视频四边形的顶点
+    void updateVideoQuad(const cv::Rect2f& area);
+
+    // 上传一个纹理平面；needRealloc 为 true 时重新分配纹理存储
+    void uploadVideoPlane(uint32_t texture, int internalFormat, uint32_t format,
+                          int width, int height, const cv::Mat& plane, bool needRealloc);
+
     // 绘制圆形
     void drawCircle(float cx, float cy, float radius, float r, float g, float b, float a = 1.0f);
 
@@ -132,7 +143,12 @@ private:
     int m_height{0};
 
     // OpenGL 资源 - 视频
-    uint32_t m_videoTexture{0};
+    uint32_t m_videoTexture{0};      // BGR 图像 / YUYV 打包数据 / NV12 的 Y 平面
+    uint32_t m_videoTextureUV{0};    // NV12 的 UV 平面
+    int m_videoFormat{-1};           // 当前纹理存储对应的 PixelFormat，-1 表示尚未分配
+    int m_videoWidth{0};
+    int m_videoHeight{0};
+    cv::Rect2f m_videoArea;          // 视频四边形当前覆盖的画面区域（归一化）
     uint32_t m_shaderProgram{0};
     uint32_t m_vao{0};
     uint32_t m_vbo{0};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace popcorn {
+
+/**
+ * 无锁三缓冲（单生产者 / 单消费者）
+ *
+ * 生产者始终写入自己独占的后台缓冲，publish() 时与中间缓冲交换索引；
+ * 消费者 update() 时把中间缓冲换到前台。两端都只交换一个原子索引，
+ * 不复制数据、不加锁，且消费者总能拿到最新发布的内容。
+ *
+ * 前台缓冲在下一次 update() 之前归消费者独占，生产者不会触碰它。
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    // 禁止拷贝
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * 生产者：获取当前可写的后台缓冲
+     */
+    T& writeBuffer() { return m_buffers[m_backIndex]; }
+
+    /**
+     * 生产者：发布后台缓冲
+     * @return 若覆盖了一个尚未被消费者取走的缓冲则返回 true
+     */
+    bool publish() {
+        uint8_t prev = m_middle.exchange(
+            static_cast<uint8_t>(m_backIndex | FRESH_BIT), std::memory_order_acq_rel);
+        m_backIndex = prev & INDEX_MASK;
+        return (prev & FRESH_BIT) != 0;
+    }
+
+    /**
+     * 消费者：若有新发布的数据则切换到前台
+     * @return 有新数据返回 true
+     */
+    bool update() {
+        if ((m_middle.load(std::memory_order_acquire) & FRESH_BIT) == 0) {
+            return false;
+        }
+        uint8_t prev = m_middle.exchange(m_frontIndex, std::memory_order_acq_rel);
+        m_frontIndex = prev & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * 消费者：获取前台缓冲（在下一次 update() 之前有效）
+     */
+    T& readBuffer() { return m_buffers[m_frontIndex]; }
+    const T& readBuffer() const { return m_buffers[m_frontIndex]; }
+
+    /**
+     * 是否有尚未被消费者取走的新数据
+     */
+    bool hasNew() const {
+        return (m_middle.load(std::memory_order_acquire) & FRESH_BIT) != 0;
+    }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x03;
+    static constexpr uint8_t FRESH_BIT = 0x04;
+
+    std::array<T, 3> m_buffers{};
+
+    // 生产者 / 消费者各自独占的索引放在不同缓存行，避免伪共享
+    alignas(64) uint8_t m_backIndex{0};
+    alignas(64) std::atomic<uint8_t> m_middle{1};
+    alignas(64) uint8_t m_frontIndex{2};
+};
+
+} // namespace popcorn
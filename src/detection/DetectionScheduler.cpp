@@ -0,0 +1,66 @@
+#include "DetectionScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace popcorn {
+
+bool DetectionScheduler::shouldDetect(int64_t timestampUs) const {
+    if (m_intervalUs <= 0 || m_lastDetectionUs == 0) {
+        return true;
+    }
+
+    int64_t elapsed = timestampUs - m_lastDetectionUs;
+    if (elapsed < 0) {
+        // 时间戳倒退（回放循环）：立即检测，重新开始计时
+        return true;
+    }
+    return elapsed >= static_cast<int64_t>(m_intervalUs * (1.0f - m_config.tolerance));
+}
+
+void DetectionScheduler::onDetection(int64_t timestampUs, float detectionMs) {
+    m_lastDetectionUs = timestampUs;
+    if (detectionMs <= 0.0f) {
+        return;
+    }
+    m_averageMs = m_averageMs > 0.0f
+        ? m_averageMs + m_config.smoothing * (detectionMs - m_averageMs)
+        : detectionMs;
+
+    // 预算内可承受的频率；预算为 1 或耗时可忽略时不限制
+    int64_t intervalUs = 0;
+    if (m_config.cpuBudget > 0.0f && m_config.cpuBudget < 1.0f) {
+        float rateHz = m_config.cpuBudget * 1000.0f / m_averageMs;
+        if (m_config.minRateHz > 0.0f) {
+            rateHz = std::max(rateHz, m_config.minRateHz);
+        }
+        intervalUs = static_cast<int64_t>(1e6f / rateHz);
+    }
+
+    // 变化不大时保持当前间隔
+    if (intervalUs > 0 && m_intervalUs > 0 &&
+        std::abs(intervalUs - m_intervalUs) < m_intervalUs * m_config.hysteresis) {
+        return;
+    }
+    if (intervalUs == m_intervalUs) {
+        return;
+    }
+
+    m_intervalUs = intervalUs;
+    std::cout << "[PoseScheduler] Detection rate ";
+    if (intervalUs > 0) {
+        std::cout << 1e6f / intervalUs << "Hz";
+    } else {
+        std::cout << "unlimited";
+    }
+    std::cout << " (inference " << m_averageMs << "ms, budget "
+              << static_cast<int>(m_config.cpuBudget * 100.0f) << "%)\n";
+}
+
+void DetectionScheduler::reset() {
+    m_averageMs = 0.0f;
+    m_lastDetectionUs = 0;
+    m_intervalUs = 0;
+}
+
+} // namespace popcorn
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+
+namespace popcorn {
+
+/**
+ * 姿态检测频率调度
+ *
+ * 按实测的推理耗时和 CPU 预算选择检测频率：频率 = 预算 / 单次耗时，
+ * 即推理占用的时间比例不超过预算（如 0.5 表示最多占用一个核心的一半）。
+ * 强 CPU 上算出的频率高于摄像头帧率，每帧都检测；弱 CPU 上降到如 15Hz，
+ * 中间的 tick 由关键点滤波（PoseFilter）外推出连续的手部位置，而不是让推理挤掉渲染帧。
+ *
+ * 耗时按指数滑动平均估计；频率变化超过一定比例才切换，避免在相邻频率间抖动。
+ * 只做决策，不接触检测器；非线程安全，由运行检测的线程独占
+ */
+class DetectionScheduler {
+public:
+    /**
+     * 调度参数
+     */
+    struct Config {
+        float cpuBudget{0.5f};          // 推理可占用的时间比例（0-1；1 表示不限制）
+        float minRateHz{10.0f};         // 频率下限：再慢跟踪和外推都不可靠，宁可超出预算
+        float smoothing{0.1f};          // 耗时滑动平均的系数
+        float hysteresis{0.15f};        // 新频率与当前频率相差超过该比例才切换
+        float tolerance{0.1f};          // 距上次检测达到间隔的 (1 - tolerance) 即可检测（吸收帧时间戳抖动）
+    };
+
+    DetectionScheduler() = default;
+    explicit DetectionScheduler(const Config& config) : m_config(config) {}
+
+    /**
+     * 这一帧是否应当检测
+     * @param timestampUs 帧的采集时间戳（steady_clock，微秒）
+     */
+    bool shouldDetect(int64_t timestampUs) const;
+
+    /**
+     * 记录一次检测，按耗时更新频率
+     * @param timestampUs 被检测帧的采集时间戳
+     * @param detectionMs 推理耗时（毫秒）
+     */
+    void onDetection(int64_t timestampUs, float detectionMs);
+
+    /**
+     * 当前检测间隔（微秒；0 表示每帧都检测）与频率（Hz；0 表示不限制）
+     */
+    int64_t getIntervalUs() const { return m_intervalUs; }
+    float getRateHz() const { return m_intervalUs > 0 ? 1e6f / m_intervalUs : 0.0f; }
+
+    /**
+     * 是否设有检测间隔（间隔短于帧间隔时实际上仍是每帧检测）
+     */
+    bool isThrottling() const { return m_intervalUs > 0; }
+
+    /**
+     * 清除历史（如帧源切换、时间戳重新开始）
+     */
+    void reset();
+
+    void setConfig(const Config& config) { m_config = config; }
+    const Config& getConfig() const { return m_config; }
+
+private:
+    Config m_config;
+    float m_averageMs{0.0f};
+    int64_t m_lastDetectionUs{0};
+    int64_t m_intervalUs{0};
+};
+
+} // namespace popcorn
@@ -1,8 +1,10 @@
 #include "GestureDetector.h"
+#include "OrtRuntime.h"
 #include <iostream>
 #include <chrono>
 #include <cmath>
 #include <fstream>
+#include <algorithm>
 
 // OpenCV
 #include <opencv2/opencv.hpp>
@@ -20,7 +22,7 @@ namespace popcorn {
  */
 struct GestureDetector::Impl {
 #ifdef HAS_ONNXRUNTIME
-    std::unique_ptr<Ort::Env> env;
+    std::shared_ptr<Ort::Env> env;              // 进程共享（OrtRuntime）
     std::unique_ptr<Ort::SessionOptions> sessionOptions;
     std::unique_ptr<Ort::Session> session;
     std::unique_ptr<Ort::MemoryInfo> memoryInfo;
@@ -53,12 +55,12 @@ bool GestureDetector::initialize(const std::string& modelPath) {
 
 #ifdef HAS_ONNXRUNTIME
     try {
-        // 创建 ONNX Runtime 环境
-        m_impl->env = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "GestureDetector");
+        // 共享的 ONNX Runtime 环境
+        m_impl->env = OrtRuntime::acquire();
 
-        // 会话选项
+        // 会话选项：使用共享环境的全局线程池，不再开私有线程
         m_impl->sessionOptions = std::make_unique<Ort::SessionOptions>();
-        m_impl->sessionOptions->SetIntraOpNumThreads(2);
+        OrtRuntime::prepareSession(*m_impl->sessionOptions);
         m_impl->sessionOptions->SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
 
         // 创建会话
@@ -122,6 +124,18 @@ void GestureDetector::shutdown() {
 }
 
 GestureResult GestureDetector::detect(const cv::Mat& frame) {
+    return detectImpl(frame, false, 1.0f);
+}
+
+GestureResult GestureDetector::detectRGB(const cv::Mat& rgb, int frameWidth, int frameHeight) {
+    (void)frameHeight;  // 检测图与原始帧宽高比相同，按宽度换算即可
+    if (rgb.empty() || frameWidth <= 0) {
+        return GestureResult{};
+    }
+    return detectImpl(rgb, true, static_cast<float>(rgb.cols) / frameWidth);
+}
+
+GestureResult GestureDetector::detectImpl(const cv::Mat& frame, bool isRGB, float scale) {
     GestureResult result;
 
     if (!m_initialized || frame.empty()) {
@@ -136,14 +150,19 @@ GestureResult GestureDetector::detect(const cv::Mat& frame) {
     if (!m_impl->hasModel) {
         // 模拟模式：使用颜色检测找手
         cv::Mat hsv;
-        cv::cvtColor(frame, hsv, cv::COLOR_BGR2HSV);
+        cv::cvtColor(frame, hsv, isRGB ? cv::COLOR_RGB2HSV : cv::COLOR_BGR2HSV);
 
         // 皮肤颜色范围 (HSV)
         cv::Mat skinMask;
         cv::inRange(hsv, cv::Scalar(0, 20, 70), cv::Scalar(20, 255, 255), skinMask);
 
+        // 阈值按全分辨率标定，缩小的输入需按比例换算
+        int kernelSize = std::max(3, static_cast<int>(std::lround(5 * scale)) | 1);
+        double minArea = 5000.0 * scale * scale;
+        float minDefectDepth = 20.0f * scale;
+
         // 形态学操作
-        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(5, 5));
+        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(kernelSize, kernelSize));
         cv::morphologyEx(skinMask, skinMask, cv::MORPH_OPEN, kernel);
         cv::morphologyEx(skinMask, skinMask, cv::MORPH_CLOSE, kernel);
 
@@ -155,7 +174,7 @@ GestureResult GestureDetector::detect(const cv::Mat& frame) {
         std::vector<std::pair<double, int>> contourAreas;
         for (size_t i = 0; i < contours.size(); ++i) {
             double area = cv::contourArea(contours[i]);
-            if (area > 5000) {  // 最小面积阈值
+            if (area > minArea) {  // 最小面积阈值
                 contourAreas.push_back({area, static_cast<int>(i)});
             }
         }
@@ -189,7 +208,7 @@ GestureResult GestureDetector::detect(const cv::Mat& frame) {
             int deepDefects = 0;
             for (const auto& d : defects) {
                 float depth = d[3] / 256.0f;  // 缺陷深度
-                if (depth > 20) {  // 深度阈值
+                if (depth > minDefectDepth) {  // 深度阈值
                     deepDefects++;
                 }
             }
@@ -203,7 +222,10 @@ GestureResult GestureDetector::detect(const cv::Mat& frame) {
                         (static_cast<float>(boundRect.width) / boundRect.height < 2.0f);
 
             // 根据位置分配到左手或右手
-            if (centerX < frame.cols / 2.0f) {
+            bool onLeft = centerX < frame.cols / 2.0f;
+            centerX /= scale;
+            centerY /= scale;
+            if (onLeft) {
                 // 画面左侧 = 用户右手（镜像）
                 result.rightHand.detected = true;
                 result.rightHand.x = centerX;
@@ -96,6 +96,15 @@ public:
      */
     GestureResult detect(const cv::Mat& frame);
 
+    /**
+     * 在采集线程生成的低分辨率检测图上检测，坐标按原始帧尺寸输出
+     * @param rgb 输入图像（RGB 格式，与原始帧宽高比相同）
+     * @param frameWidth 原始帧宽度
+     * @param frameHeight 原始帧高度
+     * @return 手势检测结果
+     */
+    GestureResult detectRGB(const cv::Mat& rgb, int frameWidth, int frameHeight);
+
     /**
      * 是否已初始化
      */
@@ -107,6 +116,14 @@ public:
     float getLastDetectionTime() const { return m_lastDetectionTime; }
 
 private:
+    /**
+     * 检测实现
+     * @param image 输入图像
+     * @param isRGB 输入为 RGB（否则为 BGR）
+     * @param scale 输入图像相对原始帧的缩放比例，阈值与输出坐标据此换算
+     */
+    GestureResult detectImpl(const cv::Mat& image, bool isRGB, float scale);
+
     /**
      * 检测 OK 手势
      * OK 手势特征：
@@ -0,0 +1,119 @@
+#include "KeypointFilter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace popcorn {
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+
+// DetectedPerson 中参与滤波的关键点
+constexpr HandPosition DetectedPerson::* KEYPOINT_FIELDS[] = {
+    &DetectedPerson::leftHand, &DetectedPerson::rightHand,
+    &DetectedPerson::shoulder, &DetectedPerson::hip, &DetectedPerson::head,
+    &DetectedPerson::leftShoulder, &DetectedPerson::rightShoulder,
+    &DetectedPerson::leftElbow, &DetectedPerson::rightElbow,
+};
+
+// 一阶低通在采样间隔 dt、截止频率 cutoff 下的平滑系数
+float smoothingFactor(float dt, float cutoff) {
+    float tau = 1.0f / (2.0f * PI * cutoff);
+    return 1.0f / (1.0f + tau / dt);
+}
+
+} // namespace
+
+float OneEuroFilter::filter(float value, float dt) {
+    if (!m_initialized || dt <= 0.0f) {
+        if (!m_initialized) {
+            m_raw = value;
+            m_value = value;
+            m_velocity = 0.0f;
+            m_initialized = true;
+        }
+        return m_value;
+    }
+
+    // 先平滑速度，再按速度决定位置的截止频率
+    float rawVelocity = (value - m_raw) / dt;
+    m_velocity += smoothingFactor(dt, m_params.derivativeCutoff) * (rawVelocity - m_velocity);
+    float cutoff = m_params.minCutoff + m_params.beta * std::abs(m_velocity);
+    m_value += smoothingFactor(dt, cutoff) * (value - m_value);
+    m_raw = value;
+    return m_value;
+}
+
+void PoseFilter::update(const std::vector<DetectedPerson>& persons, int64_t timestampUs) {
+    static_assert(sizeof(KEYPOINT_FIELDS) / sizeof(KEYPOINT_FIELDS[0]) == KEYPOINT_COUNT,
+                  "KEYPOINT_COUNT out of sync with KEYPOINT_FIELDS");
+
+    // 本轮未出现的人物丢弃其轨迹；出现的人物沿用同一 id 的轨迹
+    m_previous.swap(m_tracks);
+    m_tracks.clear();
+    for (const DetectedPerson& person : persons) {
+        auto previous = std::find_if(m_previous.begin(), m_previous.end(),
+                                     [&](const Track& track) { return track.person.id == person.id; });
+        float dt = 0.0f;
+        if (previous != m_previous.end()) {
+            m_tracks.push_back(*previous);
+            dt = (timestampUs - previous->timestampUs) / 1e6f;
+        } else {
+            m_tracks.emplace_back();
+        }
+
+        Track& track = m_tracks.back();
+        if (dt < 0.0f || dt * 1000.0f > m_params.resetGapMs) {
+            // 时间倒退（回放循环）或间隔太久：历史不再可信
+            track = Track{};
+            dt = 0.0f;
+        } else if (dt == 0.0f && previous != m_previous.end()) {
+            // 同一帧重复输入：保持原结果
+            continue;
+        }
+
+        track.person = person;
+        track.timestampUs = timestampUs;
+        for (int i = 0; i < KEYPOINT_COUNT; ++i) {
+            const HandPosition& raw = person.*KEYPOINT_FIELDS[i];
+            KeypointTrack& keypoint = track.keypoints[i];
+            if (!raw.valid) {
+                keypoint.x.reset();
+                keypoint.y.reset();
+                continue;
+            }
+            keypoint.x.setParams(m_params.euro);
+            keypoint.y.setParams(m_params.euro);
+            HandPosition& filtered = track.person.*KEYPOINT_FIELDS[i];
+            filtered.x = keypoint.x.filter(raw.x, dt);
+            filtered.y = keypoint.y.filter(raw.y, dt);
+        }
+    }
+}
+
+void PoseFilter::predict(int64_t timestampUs, std::vector<DetectedPerson>& persons) const {
+    persons.clear();
+    for (const Track& track : m_tracks) {
+        persons.push_back(track.person);
+        DetectedPerson& person = persons.back();
+
+        // 只向前外推，且不超过上限：结果很旧时停在上限处而不是一直飞出去
+        float dt = (timestampUs - track.timestampUs) / 1e6f;
+        dt = std::min(std::max(dt, 0.0f), m_params.maxPredictionMs / 1000.0f);
+        for (int i = 0; i < KEYPOINT_COUNT; ++i) {
+            HandPosition& keypoint = person.*KEYPOINT_FIELDS[i];
+            const KeypointTrack& filter = track.keypoints[i];
+            if (keypoint.valid && filter.x.isInitialized()) {
+                keypoint.x += filter.x.velocity() * dt;
+                keypoint.y += filter.y.velocity() * dt;
+            }
+        }
+    }
+}
+
+void PoseFilter::reset() {
+    m_tracks.clear();
+    m_previous.clear();
+}
+
+} // namespace popcorn
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "PoseDetector.h"
+
+namespace popcorn {
+
+/**
+ * One Euro 滤波器（单个坐标分量）
+ *
+ * 截止频率随速度自适应的一阶低通：静止时截止频率低，抑制抖动；
+ * 快速移动时截止频率升高，减少滞后。同时给出平滑后的速度，用于外推。
+ * 参见 Casiez et al., "1€ Filter", CHI 2012
+ */
+class OneEuroFilter {
+public:
+    struct Params {
+        float minCutoff{1.0f};          // 静止时的截止频率（Hz）：越小越平滑
+        float beta{0.02f};              // 截止频率随速度（像素/秒）增长的系数：越大越跟手
+        float derivativeCutoff{1.0f};   // 速度估计的截止频率（Hz）
+    };
+
+    OneEuroFilter() = default;
+    explicit OneEuroFilter(const Params& params) : m_params(params) {}
+
+    /**
+     * 输入一个采样
+     * @param value 原始值
+     * @param dt 距上一个采样的时间（秒）；首个采样忽略
+     * @return 滤波后的值
+     */
+    float filter(float value, float dt);
+
+    /**
+     * 丢弃历史，下一个采样重新开始
+     */
+    void reset() { m_initialized = false; }
+
+    bool isInitialized() const { return m_initialized; }
+    float value() const { return m_value; }
+    float velocity() const { return m_velocity; }     // 平滑后的速度（单位/秒）
+
+    void setParams(const Params& params) { m_params = params; }
+
+private:
+    Params m_params;
+    bool m_initialized{false};
+    float m_raw{0.0f};          // 上一个原始值（求速度用）
+    float m_value{0.0f};
+    float m_velocity{0.0f};
+};
+
+/**
+ * 姿态关键点滤波与外推
+ *
+ * 检测结果每个关键点各用一对 One Euro 滤波器（x、y），按源帧的采集时间戳推进；
+ * predict 用滤波后的位置和速度把关键点外推到任意时刻（如碰撞判定或渲染时刻），
+ * 抵消采集与推理带来的滞后。人物按 DetectedPerson::id 区分（多摄像头时为摄像头序号）。
+ * 关键点无效时对应的滤波器重置，重新出现时不会从旧位置拖过来。
+ */
+class PoseFilter {
+public:
+    struct Params {
+        OneEuroFilter::Params euro;
+        float maxPredictionMs{100.0f};  // 外推上限：结果太旧时不再继续外推
+        float resetGapMs{500.0f};       // 两次检测间隔超过此值时丢弃历史（速度已不可信）
+    };
+
+    PoseFilter() = default;
+    explicit PoseFilter(const Params& params) : m_params(params) {}
+
+    /**
+     * 输入一次检测结果
+     * @param persons 检测到的人物（原始关键点）
+     * @param timestampUs 源帧的采集时间戳（steady_clock，微秒）
+     */
+    void update(const std::vector<DetectedPerson>& persons, int64_t timestampUs);
+
+    /**
+     * 外推到指定时刻
+     * @param timestampUs 目标时刻（steady_clock，微秒）
+     * @param persons 输出：滤波并外推后的人物（复用其缓冲）
+     */
+    void predict(int64_t timestampUs, std::vector<DetectedPerson>& persons) const;
+
+    /**
+     * 丢弃所有历史
+     */
+    void reset();
+
+    /**
+     * 外推上限（毫秒）：检测频率降低时需覆盖两次检测之间的间隔
+     */
+    void setMaxPredictionMs(float ms) { m_params.maxPredictionMs = ms; }
+    float getMaxPredictionMs() const { return m_params.maxPredictionMs; }
+
+private:
+    // DetectedPerson 中的关键点个数（见 KEYPOINT_FIELDS）
+    static constexpr int KEYPOINT_COUNT = 9;
+
+    struct KeypointTrack {
+        OneEuroFilter x;
+        OneEuroFilter y;
+    };
+
+    struct Track {
+        DetectedPerson person;              // 最近一次的滤波结果
+        KeypointTrack keypoints[KEYPOINT_COUNT];
+        int64_t timestampUs{0};
+    };
+
+    Params m_params;
+    std::vector<Track> m_tracks;        // 按最近一次 update 的人物顺序
+    std::vector<Track> m_previous;      // update 时的上一轮轨迹（复用缓冲）
+};
+
+} // namespace popcorn
@@ -0,0 +1,257 @@
+#include "LetterboxResize.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+// x86-64 以 SSE2 为基线，AVX2 运行时检测；其他架构使用标量实现
+#if defined(__x86_64__) || defined(_M_X64)
+#define POPCORN_X86_SIMD 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC / Clang 按函数启用指令集，其余源文件仍按基线编译；MSVC 无需标注即可使用内建函数
+#if defined(__GNUC__) || defined(__clang__)
+#define POPCORN_TARGET(isa) __attribute__((target(isa)))
+#else
+#define POPCORN_TARGET(isa)
+#endif
+
+namespace popcorn {
+
+namespace {
+
+// 定点权重：水平、垂直各 7 位，两次乘加后右移 14 位
+constexpr int WEIGHT_BITS = 7;
+constexpr int WEIGHT_ONE = 1 << WEIGHT_BITS;
+constexpr int OUTPUT_SHIFT = WEIGHT_BITS * 2;
+
+// 垂直混合两行 int16 定点值并扩展为 int32：dst = (a * w0 + b * w1 + round) >> 14
+using BlendRowsFn = void (*)(const int16_t* a, const int16_t* b, int w0, int w1, int32_t* dst, int count);
+
+void blendRowsScalar(const int16_t* a, const int16_t* b, int w0, int w1, int32_t* dst, int count) {
+    const int32_t round = 1 << (OUTPUT_SHIFT - 1);
+    for (int i = 0; i < count; ++i) {
+        dst[i] = (a[i] * w0 + b[i] * w1 + round) >> OUTPUT_SHIFT;
+    }
+}
+
+#ifdef POPCORN_X86_SIMD
+
+// 交错 (a, b) 后用 madd 一步完成乘加与 int32 扩展
+POPCORN_TARGET("sse2")
+void blendRowsSse2(const int16_t* a, const int16_t* b, int w0, int w1, int32_t* dst, int count) {
+    const __m128i weights = _mm_set1_epi32((w1 << 16) | (w0 & 0xFFFF));
+    const __m128i round = _mm_set1_epi32(1 << (OUTPUT_SHIFT - 1));
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(va, vb), weights);
+        __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(va, vb), weights);
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, round), OUTPUT_SHIFT);
+        hi = _mm_srai_epi32(_mm_add_epi32(hi, round), OUTPUT_SHIFT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), hi);
+    }
+    blendRowsScalar(a + i, b + i, w0, w1, dst + i, count - i);
+}
+
+POPCORN_TARGET("avx2")
+void blendRowsAvx2(const int16_t* a, const int16_t* b, int w0, int w1, int32_t* dst, int count) {
+    const __m256i weights = _mm256_set1_epi32((w1 << 16) | (w0 & 0xFFFF));
+    const __m256i round = _mm256_set1_epi32(1 << (OUTPUT_SHIFT - 1));
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        // 256 位 unpack 在两个 128 位半区内分别交错：lo = [0..3 | 8..11]，hi = [4..7 | 12..15]
+        __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(va, vb), weights);
+        __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(va, vb), weights);
+        lo = _mm256_srai_epi32(_mm256_add_epi32(lo, round), OUTPUT_SHIFT);
+        hi = _mm256_srai_epi32(_mm256_add_epi32(hi, round), OUTPUT_SHIFT);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    blendRowsScalar(a + i, b + i, w0, w1, dst + i, count - i);
+}
+
+bool cpuHasAvx2() {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // 还需操作系统保存 YMM 寄存器（OSXSAVE + XCR0 的 SSE / AVX 位）
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif // POPCORN_X86_SIMD
+
+struct BlendKernel {
+    BlendRowsFn fn;
+    const char* name;
+};
+
+const BlendKernel& blendKernel() {
+    static const BlendKernel kernel = [] {
+#ifdef POPCORN_X86_SIMD
+        if (cpuHasAvx2()) {
+            return BlendKernel{blendRowsAvx2, "avx2"};
+        }
+        return BlendKernel{blendRowsSse2, "sse2"};
+#else
+        return BlendKernel{blendRowsScalar, "scalar"};
+#endif
+    }();
+    return kernel;
+}
+
+// 双线性采样位置：按像素中心对齐（与 cv::resize 的 INTER_LINEAR 一致），返回左 / 上侧索引与右 / 下侧权重
+void samplePosition(int dst, double inverseScale, int sourceSize, int32_t& index, int16_t& weight) {
+    double position = (dst + 0.5) * inverseScale - 0.5;
+    position = std::min(std::max(position, 0.0), static_cast<double>(sourceSize - 1));
+    int base = std::min(static_cast<int>(position), std::max(sourceSize - 2, 0));
+    index = base;
+    weight = static_cast<int16_t>(std::lround((position - base) * WEIGHT_ONE));
+}
+
+} // namespace
+
+const char* LetterboxResizer::simdName() {
+    return blendKernel().name;
+}
+
+void LetterboxResizer::prepare(const cv::Size& sourceSize, bool swapRB, int32_t* dst, int dstWidth, int dstHeight) {
+    // 保持宽高比：按较紧的一边缩放，内容居中
+    float scale = std::min(static_cast<float>(dstWidth) / sourceSize.width,
+                           static_cast<float>(dstHeight) / sourceSize.height);
+    m_contentWidth = std::min(std::max(static_cast<int>(std::lround(sourceSize.width * scale)), 1), dstWidth);
+    m_contentHeight = std::min(std::max(static_cast<int>(std::lround(sourceSize.height * scale)), 1), dstHeight);
+
+    m_transform.scale = scale;
+    m_transform.offsetX = static_cast<float>((dstWidth - m_contentWidth) / 2);
+    m_transform.offsetY = static_cast<float>((dstHeight - m_contentHeight) / 2);
+    m_transform.sourceSize = sourceSize;
+    m_transform.inputSize = cv::Size(dstWidth, dstHeight);
+    m_swapRB = swapRB;
+    m_dst = dst;
+
+    double inverseX = static_cast<double>(sourceSize.width) / m_contentWidth;
+    double inverseY = static_cast<double>(sourceSize.height) / m_contentHeight;
+    int lastColumn = sourceSize.width - 1;
+
+    m_xOffset0.resize(m_contentWidth);
+    m_xOffset1.resize(m_contentWidth);
+    m_xWeight.resize(m_contentWidth);
+    for (int x = 0; x < m_contentWidth; ++x) {
+        int32_t index = 0;
+        samplePosition(x, inverseX, sourceSize.width, index, m_xWeight[x]);
+        m_xOffset0[x] = index * 3;
+        m_xOffset1[x] = std::min(index + 1, lastColumn) * 3;
+    }
+
+    m_yIndex.resize(m_contentHeight);
+    m_yWeight.resize(m_contentHeight);
+    for (int y = 0; y < m_contentHeight; ++y) {
+        samplePosition(y, inverseY, sourceSize.height, m_yIndex[y], m_yWeight[y]);
+    }
+
+    for (auto& row : m_rows) {
+        row.resize(static_cast<size_t>(m_contentWidth) * 3);
+    }
+
+    // 补边区域之后不再写入，只在布局变化时清零内容区域之外的部分
+    const int offsetX = static_cast<int>(m_transform.offsetX);
+    const int offsetY = static_cast<int>(m_transform.offsetY);
+    const size_t rightValues = static_cast<size_t>(dstWidth - offsetX - m_contentWidth) * 3;
+    for (int y = 0; y < dstHeight; ++y) {
+        int32_t* row = dst + static_cast<size_t>(y) * dstWidth * 3;
+        if (y < offsetY || y >= offsetY + m_contentHeight) {
+            std::memset(row, 0, sizeof(int32_t) * dstWidth * 3);
+            continue;
+        }
+        std::memset(row, 0, sizeof(int32_t) * offsetX * 3);
+        std::memset(row + (offsetX + m_contentWidth) * 3, 0, sizeof(int32_t) * rightValues);
+    }
+}
+
+void LetterboxResizer::resizeRow(const uint8_t* src, int16_t* out) const {
+    // 输出始终为 RGB：源为 BGR 时读取顺序为 2, 1, 0
+    const int c0 = m_swapRB ? 2 : 0;
+    const int c2 = m_swapRB ? 0 : 2;
+    for (int x = 0; x < m_contentWidth; ++x) {
+        const uint8_t* p0 = src + m_xOffset0[x];
+        const uint8_t* p1 = src + m_xOffset1[x];
+        const int w1 = m_xWeight[x];
+        const int w0 = WEIGHT_ONE - w1;
+        out[0] = static_cast<int16_t>(p0[c0] * w0 + p1[c0] * w1);
+        out[1] = static_cast<int16_t>(p0[1] * w0 + p1[1] * w1);
+        out[2] = static_cast<int16_t>(p0[c2] * w0 + p1[c2] * w1);
+        out += 3;
+    }
+}
+
+LetterboxTransform LetterboxResizer::run(const cv::Mat& src, bool swapRB, int32_t* dst,
+                                         int dstWidth, int dstHeight) {
+    if (src.empty() || src.type() != CV_8UC3 || !dst) {
+        std::cerr << "[PoseDetector] Letterbox input must be a non-empty CV_8UC3 image\n";
+        return m_transform;
+    }
+
+    const cv::Size sourceSize(src.cols, src.rows);
+    if (sourceSize != m_transform.sourceSize || swapRB != m_swapRB || dst != m_dst ||
+        dstWidth != m_transform.inputSize.width || dstHeight != m_transform.inputSize.height) {
+        prepare(sourceSize, swapRB, dst, dstWidth, dstHeight);
+    }
+
+    const BlendRowsFn blend = blendKernel().fn;
+    const int lastRow = sourceSize.height - 1;
+    const int rowValues = m_contentWidth * 3;
+    const int offsetX = static_cast<int>(m_transform.offsetX);
+    const int offsetY = static_cast<int>(m_transform.offsetY);
+
+    // 相邻输出行通常共用源行：两行缓存按源行号复用，只在本帧内有效
+    m_rowIndex[0] = -1;
+    m_rowIndex[1] = -1;
+    auto fetchRow = [&](int row, int keep) -> const int16_t* {
+        for (int k = 0; k < 2; ++k) {
+            if (m_rowIndex[k] == row) {
+                return m_rows[k].data();
+            }
+        }
+        int slot = m_rowIndex[0] == keep ? 1 : 0;
+        resizeRow(src.ptr(row), m_rows[slot].data());
+        m_rowIndex[slot] = row;
+        return m_rows[slot].data();
+    };
+
+    for (int y = 0; y < m_contentHeight; ++y) {
+        int top = m_yIndex[y];
+        int bottom = std::min(top + 1, lastRow);
+        const int16_t* topRow = fetchRow(top, bottom);
+        const int16_t* bottomRow = fetchRow(bottom, top);
+
+        int w1 = m_yWeight[y];
+        int32_t* out = dst + (static_cast<size_t>(offsetY + y) * dstWidth + offsetX) * 3;
+        blend(topRow, bottomRow, WEIGHT_ONE - w1, w1, out, rowValues);
+    }
+
+    return m_transform;
+}
+
+} // namespace popcorn
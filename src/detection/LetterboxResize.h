@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+namespace popcorn {
+
+/**
+ * 信箱缩放的坐标变换
+ * 源图按同一比例缩放后居中放入模型输入，四周补 0；输入像素 = 源像素 * scale + offset
+ */
+struct LetterboxTransform {
+    float scale{1.0f};
+    float offsetX{0.0f};
+    float offsetY{0.0f};
+    cv::Size sourceSize;
+    cv::Size inputSize;
+
+    /**
+     * 模型输出的归一化坐标（相对整个输入）映射回源图像素坐标
+     */
+    cv::Point2f toSource(float x, float y) const {
+        return cv::Point2f((x * inputSize.width - offsetX) / scale, (y * inputSize.height - offsetY) / scale);
+    }
+};
+
+/**
+ * 融合的模型输入预处理
+ *
+ * 一次遍历完成保持宽高比的信箱缩放（双线性）、BGR -> RGB 通道交换和 uint8 -> int32 扩展，
+ * 直接写入模型绑定的输入缓冲，不产生中间图像：
+ * - 水平缩放按预先计算的列表逐行进行，同时交换通道，结果为 7 位定点的 int16 行（只缓存两行）；
+ * - 垂直混合两行并扩展为 int32，这是连续内存上的定点乘加，按 CPU 支持选择 AVX2 / SSE2 / 标量实现。
+ * 列表和补边只在源尺寸或输出缓冲变化时重建（开销与输入边长成正比，逐帧变化的裁剪区域也可承受）。
+ */
+class LetterboxResizer {
+public:
+    LetterboxResizer() = default;
+
+    /**
+     * 预处理一帧
+     * @param src 源图（CV_8UC3，可以是 ROI）
+     * @param swapRB 源图为 BGR 时传 true（输出始终为 RGB）
+     * @param dst 输出缓冲（dstWidth * dstHeight * 3 个 int32，NHWC）
+     * @param dstWidth 模型输入宽度
+     * @param dstHeight 模型输入高度
+     * @return 源图到模型输入的坐标变换
+     */
+    LetterboxTransform run(const cv::Mat& src, bool swapRB, int32_t* dst, int dstWidth, int dstHeight);
+
+    /**
+     * 当前 CPU 上使用的实现（用于日志）
+     */
+    static const char* simdName();
+
+private:
+    // 源尺寸或输出缓冲变化时重建列表并清零补边区域
+    void prepare(const cv::Size& sourceSize, bool swapRB, int32_t* dst, int dstWidth, int dstHeight);
+
+    // 水平缩放一行源像素到 int16 定点行（同时交换通道）
+    void resizeRow(const uint8_t* src, int16_t* out) const;
+
+private:
+    LetterboxTransform m_transform;
+    bool m_swapRB{false};
+    int32_t* m_dst{nullptr};
+    int m_contentWidth{0};
+    int m_contentHeight{0};
+
+    // 每个输出列：左右两个源像素的字节偏移和右侧权重（0-128）
+    std::vector<int32_t> m_xOffset0;
+    std::vector<int32_t> m_xOffset1;
+    std::vector<int16_t> m_xWeight;
+
+    // 每个输出行：上方源行号和下方权重（0-128）
+    std::vector<int32_t> m_yIndex;
+    std::vector<int16_t> m_yWeight;
+
+    // 两行水平缩放结果的缓存（按源行号复用）
+    std::vector<int16_t> m_rows[2];
+    int m_rowIndex[2]{-1, -1};
+};
+
+} // namespace popcorn
@@ -0,0 +1,89 @@
+#include "OrtRuntime.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+
+#ifdef HAS_ONNXRUNTIME
+#include <onnxruntime_cxx_api.h>
+#endif
+
+namespace popcorn {
+
+namespace {
+
+std::mutex g_mutex;
+OrtRuntimeConfig g_config;
+std::atomic<OrtRuntime::RunObserver> g_runObserver{nullptr};
+
+#ifdef HAS_ONNXRUNTIME
+std::weak_ptr<Ort::Env> g_env;
+#endif
+
+} // namespace
+
+bool OrtRuntime::configure(const OrtRuntimeConfig& config) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+#ifdef HAS_ONNXRUNTIME
+    if (!g_env.expired()) {
+        std::cerr << "[OrtRuntime] Environment already created, thread config ignored\n";
+        return false;
+    }
+#endif
+    g_config = config;
+    return true;
+}
+
+OrtRuntimeConfig OrtRuntime::getConfig() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_config;
+}
+
+void OrtRuntime::setRunObserver(RunObserver observer) {
+    g_runObserver.store(observer, std::memory_order_release);
+}
+
+#ifdef HAS_ONNXRUNTIME
+std::shared_ptr<Ort::Env> OrtRuntime::acquire() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    std::shared_ptr<Ort::Env> env = g_env.lock();
+    if (env) {
+        return env;
+    }
+
+    // 全局线程池：所有禁用了私有线程池的会话共用
+    Ort::ThreadingOptions threading;
+    threading.SetGlobalIntraOpNumThreads(std::max(g_config.intraOpThreads, 1));
+    threading.SetGlobalInterOpNumThreads(std::max(g_config.interOpThreads, 1));
+    threading.SetGlobalSpinControl(g_config.allowSpinning ? 1 : 0);
+    env = std::make_shared<Ort::Env>(threading, ORT_LOGGING_LEVEL_WARNING, "Popcorn");
+    g_env = env;
+
+    std::cout << "[OrtRuntime] Shared environment created: intra-op " << g_config.intraOpThreads
+              << " threads, inter-op " << g_config.interOpThreads << " threads, spinning "
+              << (g_config.allowSpinning ? "on" : "off") << "\n";
+    return env;
+}
+
+void OrtRuntime::prepareSession(Ort::SessionOptions& options) {
+    options.DisablePerSessionThreads();
+}
+
+void OrtRuntime::run(Ort::Session& session, const Ort::RunOptions& options, Ort::IoBinding& binding) {
+    RunObserver observer = g_runObserver.load(std::memory_order_acquire);
+    if (!observer) {
+        session.Run(options, binding);
+        return;
+    }
+
+    // Run 抛出异常时同样通知结束
+    struct Scope {
+        RunObserver observer;
+        explicit Scope(RunObserver o) : observer(o) { observer(true); }
+        ~Scope() { observer(false); }
+    } scope(observer);
+    session.Run(options, binding);
+}
+#endif
+
+} // namespace popcorn
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+
+#ifdef HAS_ONNXRUNTIME
+namespace Ort {
+struct Env;
+struct IoBinding;
+struct RunOptions;
+struct Session;
+struct SessionOptions;
+}
+#endif
+
+namespace popcorn {
+
+/**
+ * 进程级 ONNX Runtime 线程配置
+ */
+struct OrtRuntimeConfig {
+    int intraOpThreads{2};      // 全局 intra-op 线程池大小（含调用 Run 的线程）
+    int interOpThreads{1};      // 全局 inter-op 线程池大小（仅并行执行模式使用）
+    bool allowSpinning{false};  // 线程池空闲时自旋等待：唤醒略快，但会占满核心，与渲染、采集线程争抢
+};
+
+/**
+ * 进程内共享的 ONNX Runtime 环境
+ *
+ * 所有检测器的会话共用一个 Ort::Env 及其全局 intra / inter-op 线程池，
+ * 会话本身禁用私有线程池（DisablePerSessionThreads）。此前每个检测器各建一个 Env、
+ * 各开两个会自旋的线程，检测器一多就超额占用渲染和采集线程需要的核心。
+ *
+ * 环境在第一次 acquire 时按当前配置创建，最后一个持有者释放后销毁；
+ * 配置须在创建之前设置（通常在 main 中、初始化检测器之前）
+ */
+class OrtRuntime {
+public:
+    /**
+     * 设置线程配置
+     * @return 环境已创建（配置不再生效）时返回 false
+     */
+    static bool configure(const OrtRuntimeConfig& config);
+
+    /**
+     * 当前线程配置
+     */
+    static OrtRuntimeConfig getConfig();
+
+    /**
+     * 推理观察者：每次 run 前后分别以 true / false 调用（在调用 run 的线程）
+     * 用于把 ORT 内部的开销与调用方自己的开销分开统计，如分配计数测试在推理期间暂停计数
+     */
+    using RunObserver = void (*)(bool running);
+    static void setRunObserver(RunObserver observer);
+
+#ifdef HAS_ONNXRUNTIME
+    /**
+     * 获取共享环境（不存在时创建）；会话须在返回的引用释放之前销毁
+     */
+    static std::shared_ptr<Ort::Env> acquire();
+
+    /**
+     * 让会话使用共享环境的全局线程池（创建会话之前调用）
+     */
+    static void prepareSession(Ort::SessionOptions& options);
+
+    /**
+     * 执行输入输出已绑定的推理（通知推理观察者）
+     */
+    static void run(Ort::Session& session, const Ort::RunOptions& options, Ort::IoBinding& binding);
+#endif
+};
+
+} // namespace popcorn
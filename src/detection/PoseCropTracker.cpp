@@ -0,0 +1,106 @@
+#include "PoseCropTracker.h"
+#include <algorithm>
+#include <cmath>
+
+namespace popcorn {
+
+namespace {
+
+// 参与裁剪计算的关键点最低置信度（与 MoveNet 参考实现一致）
+constexpr float MIN_CROP_KEYPOINT_SCORE = 0.2f;
+
+// 半边长相对躯干 / 全身关键点到中心最大距离的放大倍数
+constexpr float TORSO_EXPANSION = 1.9f;
+constexpr float BODY_EXPANSION = 1.2f;
+
+// 裁剪边长下限（相对整帧短边），避免关键点聚在一起时放大到只剩噪声
+constexpr float MIN_CROP_FRACTION = 0.25f;
+
+bool visible(const HandPosition& keypoint) {
+    return keypoint.visibility > MIN_CROP_KEYPOINT_SCORE;
+}
+
+const HandPosition& keypointAt(const MoveNetKeypoints& keypoints, MoveNetKeypoint index) {
+    return keypoints[static_cast<size_t>(index)];
+}
+
+} // namespace
+
+cv::Rect PoseCropTracker::cropRect(const cv::Size& imageSize) const {
+    const cv::Rect image(0, 0, imageSize.width, imageSize.height);
+    if (!m_tracking) {
+        return image;
+    }
+
+    int x0 = static_cast<int>(std::floor(m_region.x * imageSize.width));
+    int y0 = static_cast<int>(std::floor(m_region.y * imageSize.height));
+    int x1 = static_cast<int>(std::ceil((m_region.x + m_region.width) * imageSize.width));
+    int y1 = static_cast<int>(std::ceil((m_region.y + m_region.height) * imageSize.height));
+    cv::Rect crop = cv::Rect(x0, y0, x1 - x0, y1 - y0) & image;
+    return crop.width >= 2 && crop.height >= 2 ? crop : image;
+}
+
+void PoseCropTracker::update(const MoveNetKeypoints& keypoints, const cv::Size& frameSize) {
+    const HandPosition& leftHip = keypointAt(keypoints, MoveNetKeypoint::LeftHip);
+    const HandPosition& rightHip = keypointAt(keypoints, MoveNetKeypoint::RightHip);
+    const HandPosition& leftShoulder = keypointAt(keypoints, MoveNetKeypoint::LeftShoulder);
+    const HandPosition& rightShoulder = keypointAt(keypoints, MoveNetKeypoint::RightShoulder);
+
+    // 至少一侧髋部和一侧肩部可见才能确定中心和躯干尺度
+    if (frameSize.width <= 0 || frameSize.height <= 0 ||
+        !(visible(leftHip) || visible(rightHip)) || !(visible(leftShoulder) || visible(rightShoulder))) {
+        reset();
+        return;
+    }
+
+    float centerX = 0.0f;
+    float centerY = 0.0f;
+    int hipCount = 0;
+    for (const HandPosition* hip : {&leftHip, &rightHip}) {
+        if (visible(*hip)) {
+            centerX += hip->x;
+            centerY += hip->y;
+            ++hipCount;
+        }
+    }
+    centerX /= hipCount;
+    centerY /= hipCount;
+
+    // 躯干与全身可见关键点到中心的最大横 / 纵距离
+    float torsoRange = 0.0f;
+    for (const HandPosition* joint : {&leftShoulder, &rightShoulder, &leftHip, &rightHip}) {
+        if (visible(*joint)) {
+            torsoRange = std::max({torsoRange, std::abs(joint->x - centerX), std::abs(joint->y - centerY)});
+        }
+    }
+    float bodyRange = 0.0f;
+    for (const HandPosition& keypoint : keypoints) {
+        if (visible(keypoint)) {
+            bodyRange = std::max({bodyRange, std::abs(keypoint.x - centerX), std::abs(keypoint.y - centerY)});
+        }
+    }
+
+    const float width = static_cast<float>(frameSize.width);
+    const float height = static_cast<float>(frameSize.height);
+    float halfLength = std::max(torsoRange * TORSO_EXPANSION, bodyRange * BODY_EXPANSION);
+    halfLength = std::max(halfLength, std::min(width, height) * MIN_CROP_FRACTION * 0.5f);
+    // 不超过中心到整帧最远边的距离：再大只是多补边
+    halfLength = std::min(halfLength, std::max({centerX, width - centerX, centerY, height - centerY}));
+
+    // 正方形已经能覆盖整帧长边的一半：裁剪没有收益，直接整帧检测
+    if (halfLength >= std::max(width, height) * 0.5f) {
+        reset();
+        return;
+    }
+
+    m_region = cv::Rect2f((centerX - halfLength) / width, (centerY - halfLength) / height,
+                          halfLength * 2.0f / width, halfLength * 2.0f / height);
+    m_tracking = true;
+}
+
+void PoseCropTracker::reset() {
+    m_region = cv::Rect2f(0.0f, 0.0f, 1.0f, 1.0f);
+    m_tracking = false;
+}
+
+} // namespace popcorn
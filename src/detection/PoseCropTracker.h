@@ -0,0 +1,57 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include "PoseDetector.h"
+
+namespace popcorn {
+
+/**
+ * MoveNet 智能裁剪（帧间 ROI 跟踪）
+ *
+ * MoveNet 按"上一帧的人物周围裁一块正方形再检测"设计：人物占满模型输入时，
+ * 小模型也能得到接近大模型的手腕精度。本类根据上一帧的 17 个关键点给出下一帧的裁剪区域：
+ * - 躯干（肩、髋）可见时，以髋部中心为中心，边长覆盖躯干与全身关键点并留余量；
+ * - 躯干不可见、区域覆盖整帧或结果太小时视为跟丢，退回整帧检测。
+ *
+ * 区域以相对整帧的归一化坐标保存，检测图与全分辨率图宽高比相同时可互换使用。
+ * 每个视频流一个实例（多摄像头共用同一个 PoseDetector 时各自跟踪），只由检测所在线程访问
+ */
+class PoseCropTracker {
+public:
+    PoseCropTracker() = default;
+
+    /**
+     * 下一次检测使用的裁剪区域
+     * @param imageSize 送入检测器的图像尺寸
+     * @return 图像内的像素区域（正方形被图像边界截断的部分不含在内）；未跟踪时为整幅图像
+     */
+    cv::Rect cropRect(const cv::Size& imageSize) const;
+
+    /**
+     * 用本次检测的关键点计算下一帧的裁剪区域
+     * @param keypoints 整帧像素坐标的关键点
+     * @param frameSize 整帧尺寸
+     */
+    void update(const MoveNetKeypoints& keypoints, const cv::Size& frameSize);
+
+    /**
+     * 跟丢或视频流切换时退回整帧
+     */
+    void reset();
+
+    /**
+     * 是否正在跟踪（裁剪区域小于整帧）
+     */
+    bool isTracking() const { return m_tracking; }
+
+    /**
+     * 当前裁剪区域（相对整帧的归一化坐标，可能超出 0-1）
+     */
+    const cv::Rect2f& getRegion() const { return m_region; }
+
+private:
+    cv::Rect2f m_region{0.0f, 0.0f, 1.0f, 1.0f};
+    bool m_tracking{false};
+};
+
+} // namespace popcorn
@@ -1,5 +1,9 @@
 #include "PoseDetector.h"
+#include "LetterboxResize.h"
+#include "OrtRuntime.h"
+#include "PoseCropTracker.h"
 #include <iostream>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <fstream>
@@ -22,12 +26,26 @@ namespace popcorn {
  */
 struct PoseDetector::Impl {
 #ifdef HAS_ONNXRUNTIME
-    std::unique_ptr<Ort::Env> env;
+    std::shared_ptr<Ort::Env> env;              // 进程共享（OrtRuntime）
     std::unique_ptr<Ort::Session> session;
     std::unique_ptr<Ort::SessionOptions> sessionOptions;
     std::unique_ptr<Ort::MemoryInfo> memoryInfo;
+
+    // 推理路径在 initialize 中一次准备好：名称、张量缓冲与绑定，逐帧只改写输入数据
+    std::string inputName;
+    std::string outputName;
+    std::vector<int32_t> inputData;         // [1, H, W, 3]，模型期望 int32（值 0-255）
+    std::vector<float> outputData;          // [1, 1, 17, 3]
+    Ort::Value inputTensor{nullptr};
+    Ort::Value outputTensor{nullptr};
+    std::unique_ptr<Ort::IoBinding> binding;
+    bool outputBound{false};                // 输出形状不固定时由 ORT 分配输出
+    Ort::RunOptions runOptions;
 #endif
     bool hasModel{false};
+
+    // 预处理：源图一次遍历写入 inputData（信箱缩放 + 通道交换 + int32 扩展）
+    LetterboxResizer letterbox;
 };
 
 PoseDetector::PoseDetector() : m_impl(std::make_unique<Impl>()) {}
@@ -49,12 +67,12 @@ bool PoseDetector::initialize(const std::string& modelPath) {
 
 #ifdef HAS_ONNXRUNTIME
     try {
-        // 创建 ONNX Runtime 环境
-        m_impl->env = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "PoseDetector");
+        // 共享的 ONNX Runtime 环境
+        m_impl->env = OrtRuntime::acquire();
 
-        // 会话选项
+        // 会话选项：使用共享环境的全局线程池，不再开私有线程
         m_impl->sessionOptions = std::make_unique<Ort::SessionOptions>();
-        m_impl->sessionOptions->SetIntraOpNumThreads(2);
+        OrtRuntime::prepareSession(*m_impl->sessionOptions);
         m_impl->sessionOptions->SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
 
 #ifdef _WIN32
@@ -81,17 +99,24 @@ bool PoseDetector::initialize(const std::string& modelPath) {
             Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault)
         );
 
-        // 获取输入信息
+        // 获取输入 / 输出信息（名称只在这里查询一次）
         Ort::AllocatorWithDefaultOptions allocator;
-        auto inputName = m_impl->session->GetInputNameAllocated(0, allocator);
+        m_impl->inputName = m_impl->session->GetInputNameAllocated(0, allocator).get();
+        m_impl->outputName = m_impl->session->GetOutputNameAllocated(0, allocator).get();
         auto inputShape = m_impl->session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+        auto outputShape = m_impl->session->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
 
-        std::cout << "[PoseDetector] Input name: " << inputName.get() << "\n";
+        std::cout << "[PoseDetector] Input name: " << m_impl->inputName << "\n";
         std::cout << "[PoseDetector] Input shape: ";
         for (auto dim : inputShape) {
             std::cout << dim << " ";
         }
         std::cout << "\n";
+        std::cout << "[PoseDetector] Output shape: ";
+        for (auto dim : outputShape) {
+            std::cout << dim << " ";
+        }
+        std::cout << "\n";
 
         // 根据模型设置输入尺寸
         if (inputShape.size() >= 4) {
@@ -99,10 +124,15 @@ bool PoseDetector::initialize(const std::string& modelPath) {
             m_inputWidth = static_cast<int>(inputShape[2]);
         }
 
+        if (!bindTensors(outputShape)) {
+            return false;
+        }
+
         m_impl->hasModel = true;
         m_initialized = true;
         std::cout << "[PoseDetector] Initialized successfully! Input size: "
-                  << m_inputWidth << "x" << m_inputHeight << "\n";
+                  << m_inputWidth << "x" << m_inputHeight << " (preprocess: "
+                  << LetterboxResizer::simdName() << ")\n";
         return true;
 
     } catch (const Ort::Exception& e) {
@@ -118,9 +148,50 @@ bool PoseDetector::initialize(const std::string& modelPath) {
 #endif
 }
 
+bool PoseDetector::bindTensors(const std::vector<int64_t>& outputShape) {
+#ifdef HAS_ONNXRUNTIME
+    // 输入缓冲按模型输入尺寸预分配，张量直接引用它
+    const std::vector<int64_t> inputShape = {1, m_inputHeight, m_inputWidth, 3};
+    m_impl->inputData.assign(static_cast<size_t>(m_inputHeight) * m_inputWidth * 3, 0);
+    m_impl->inputTensor = Ort::Value::CreateTensor<int32_t>(
+        *m_impl->memoryInfo, m_impl->inputData.data(), m_impl->inputData.size(),
+        inputShape.data(), inputShape.size());
+
+    m_impl->binding = std::make_unique<Ort::IoBinding>(*m_impl->session);
+    m_impl->binding->BindInput(m_impl->inputName.c_str(), m_impl->inputTensor);
+
+    // 输出形状固定时同样预分配并绑定；含动态维度时退回由 ORT 按次分配
+    size_t outputCount = 1;
+    bool staticOutput = !outputShape.empty();
+    for (int64_t dim : outputShape) {
+        staticOutput = staticOutput && dim > 0;
+        outputCount *= static_cast<size_t>(std::max<int64_t>(dim, 1));
+    }
+    if (staticOutput && outputCount >= 17 * 3) {
+        m_impl->outputData.assign(outputCount, 0.0f);
+        m_impl->outputTensor = Ort::Value::CreateTensor<float>(
+            *m_impl->memoryInfo, m_impl->outputData.data(), m_impl->outputData.size(),
+            outputShape.data(), outputShape.size());
+        m_impl->binding->BindOutput(m_impl->outputName.c_str(), m_impl->outputTensor);
+        m_impl->outputBound = true;
+    } else {
+        std::cout << "[PoseDetector] Output shape is dynamic, output allocated per inference\n";
+        m_impl->binding->BindOutput(m_impl->outputName.c_str(), *m_impl->memoryInfo);
+        m_impl->outputBound = false;
+    }
+    return true;
+#else
+    (void)outputShape;
+    return false;
+#endif
+}
+
 void PoseDetector::shutdown() {
 #ifdef HAS_ONNXRUNTIME
     if (m_impl) {
+        m_impl->binding.reset();
+        m_impl->inputTensor = Ort::Value{nullptr};
+        m_impl->outputTensor = Ort::Value{nullptr};
         m_impl->session.reset();
         m_impl->sessionOptions.reset();
         m_impl->memoryInfo.reset();
@@ -132,37 +203,33 @@ void PoseDetector::shutdown() {
     std::cout << "[PoseDetector] Shutdown complete\n";
 }
 
-cv::Mat PoseDetector::preprocessImage(const cv::Mat& frame) {
-    cv::Mat resized, rgb;
-
-    // BGR -> RGB
-    cv::cvtColor(frame, rgb, cv::COLOR_BGR2RGB);
-
-    // 调整大小
-    cv::resize(rgb, resized, cv::Size(m_inputWidth, m_inputHeight));
-
-    // 保持 uint8 格式，值范围 0-255（模型期望 int32，但值相同）
-    return resized;
+void PoseDetector::decodeKeypoints(const float* output, const LetterboxTransform& transform, const cv::Rect& crop,
+                                   const cv::Size& imageSize, int frameWidth, int frameHeight,
+                                   MoveNetKeypoints& keypoints) const {
+    // MoveNet 输出格式: [1, 1, 17, 3]
+    // 每个关键点: [y, x, confidence]，坐标相对整个（含补边的）模型输入归一化
+    const float toFrameX = static_cast<float>(frameWidth) / imageSize.width;
+    const float toFrameY = static_cast<float>(frameHeight) / imageSize.height;
+    for (int i = 0; i < MOVENET_KEYPOINT_COUNT; ++i) {
+        float y = output[i * 3 + 0];
+        float x = output[i * 3 + 1];
+        float conf = output[i * 3 + 2];
+
+        cv::Point2f source = transform.toSource(x, y);
+        HandPosition& pos = keypoints[i];
+        pos.x = (source.x + crop.x) * toFrameX;
+        pos.y = (source.y + crop.y) * toFrameY;
+        pos.visibility = conf;
+        pos.valid = conf > m_confidenceThreshold;
+    }
 }
 
-DetectedPerson PoseDetector::parseOutput(const float* output, int frameWidth, int frameHeight) {
+DetectedPerson PoseDetector::parseOutput(const MoveNetKeypoints& keypoints) const {
     DetectedPerson person;
     person.id = 0;
 
-    // MoveNet 输出格式: [1, 1, 17, 3]
-    // 每个关键点: [y, x, confidence]
     auto getKeypoint = [&](int index) -> HandPosition {
-        HandPosition pos;
-        float y = output[index * 3 + 0];
-        float x = output[index * 3 + 1];
-        float conf = output[index * 3 + 2];
-
-        pos.x = x * frameWidth;
-        pos.y = y * frameHeight;
-        pos.visibility = conf;
-        pos.valid = conf > m_confidenceThreshold;
-
-        return pos;
+        return keypoints[index];
     };
 
     // 提取关键点
@@ -198,95 +265,81 @@ DetectedPerson PoseDetector::parseOutput(const float* output, int frameWidth, in
 }
 
 std::vector<DetectedPerson> PoseDetector::detect(const cv::Mat& frame) {
+    std::vector<DetectedPerson> persons;
+    detectImpl(frame, false, frame.cols, frame.rows, persons, nullptr);
+    return persons;
+}
+
+std::vector<DetectedPerson> PoseDetector::detectRGB(const cv::Mat& rgb, int frameWidth, int frameHeight) {
+    std::vector<DetectedPerson> persons;
+    detectImpl(rgb, true, frameWidth, frameHeight, persons, nullptr);
+    return persons;
+}
+
+void PoseDetector::detect(const cv::Mat& frame, std::vector<DetectedPerson>& persons,
+                          PoseCropTracker* tracker) {
+    detectImpl(frame, false, frame.cols, frame.rows, persons, tracker);
+}
+
+void PoseDetector::detectRGB(const cv::Mat& rgb, int frameWidth, int frameHeight,
+                             std::vector<DetectedPerson>& persons, PoseCropTracker* tracker) {
+    detectImpl(rgb, true, frameWidth, frameHeight, persons, tracker);
+}
+
+void PoseDetector::detectImpl(const cv::Mat& frame, bool isRGB, int frameWidth, int frameHeight,
+                              std::vector<DetectedPerson>& persons, PoseCropTracker* tracker) {
+    persons.clear();
     if (!m_initialized || frame.empty()) {
-        return {};
+        return;
     }
 
 #ifndef HAS_ONNXRUNTIME
-    return {};
+    (void)isRGB;
+    (void)frameWidth;
+    (void)frameHeight;
+    (void)tracker;
 #else
     if (!m_impl->hasModel) {
-        return {};
+        return;
     }
 
     auto startTime = std::chrono::steady_clock::now();
 
-    std::vector<DetectedPerson> persons;
-
     try {
-        // 预处理
-        cv::Mat input = preprocessImage(frame);
-
-        // 准备输入张量 (int32 格式，值范围 0-255)
-        std::vector<int64_t> inputShape = {1, m_inputHeight, m_inputWidth, 3};
-        size_t inputSize = m_inputHeight * m_inputWidth * 3;
-        std::vector<int32_t> inputData(inputSize);
-
-        // 将 uint8 转换为 int32
-        for (size_t i = 0; i < inputSize; ++i) {
-            inputData[i] = static_cast<int32_t>(input.data[i]);
+        // 预处理直接写入已绑定的输入缓冲：保持宽高比缩放、BGR -> RGB、uint8 -> int32 一次完成，
+        // 按行距读取，ROI 等非连续输入也无需先拷贝
+        if (frame.type() != CV_8UC3) {
+            std::cerr << "[PoseDetector] Unexpected input " << frame.cols << "x" << frame.rows
+                      << "x" << frame.channels() << "\n";
+            return;
         }
-
-        // 创建输入张量 (int32)
-        Ort::Value inputTensor = Ort::Value::CreateTensor<int32_t>(
-            *m_impl->memoryInfo,
-            inputData.data(),
-            inputSize,
-            inputShape.data(),
-            inputShape.size()
-        );
-
-        // 获取输入/输出名称
-        Ort::AllocatorWithDefaultOptions allocator;
-        auto inputName = m_impl->session->GetInputNameAllocated(0, allocator);
-        auto outputName = m_impl->session->GetOutputNameAllocated(0, allocator);
-
-        const char* inputNames[] = {inputName.get()};
-        const char* outputNames[] = {outputName.get()};
-
-        // 推理
-        auto outputTensors = m_impl->session->Run(
-            Ort::RunOptions{nullptr},
-            inputNames,
-            &inputTensor,
-            1,
-            outputNames,
-            1
-        );
-
-        // 获取输出形状并打印调试信息
-        auto outputInfo = outputTensors[0].GetTensorTypeAndShapeInfo();
-        auto outputShape = outputInfo.GetShape();
-
-        static int debugCount = 0;
-        if (debugCount < 5) {
-            std::cout << "[PoseDetector] Output shape: ";
-            for (auto dim : outputShape) {
-                std::cout << dim << " ";
-            }
-            std::cout << "\n";
+        // 跟踪中只取上一帧人物周围的区域（ROI 视图，不拷贝）
+        const cv::Size imageSize(frame.cols, frame.rows);
+        const cv::Rect crop = tracker ? tracker->cropRect(imageSize) : cv::Rect(0, 0, frame.cols, frame.rows);
+        const cv::Mat source = crop.size() == imageSize ? frame : frame(crop);
+        LetterboxTransform transform = m_impl->letterbox.run(
+            source, !isRGB, m_impl->inputData.data(), m_inputWidth, m_inputHeight);
+
+        // 推理：输入输出都已绑定到预分配的缓冲，不再查询名称、不再创建张量
+        OrtRuntime::run(*m_impl->session, m_impl->runOptions, *m_impl->binding);
+
+        const float* outputData = nullptr;
+        Ort::Value dynamicOutput{nullptr};
+        if (m_impl->outputBound) {
+            outputData = m_impl->outputData.data();
+        } else {
+            std::vector<Ort::Value> outputs = m_impl->binding->GetOutputValues();
+            dynamicOutput = std::move(outputs.front());
+            outputData = dynamicOutput.GetTensorData<float>();
         }
 
-        // 解析输出
-        float* outputData = outputTensors[0].GetTensorMutableData<float>();
-
-        // 打印前几个关键点的原始值（调试用）
-        if (debugCount < 5) {
-            std::cout << "[PoseDetector] Raw output (first 10 values): ";
-            for (int i = 0; i < 10 && i < static_cast<int>(outputInfo.GetElementCount()); ++i) {
-                std::cout << outputData[i] << " ";
-            }
-            std::cout << "\n";
-
-            // 打印左手腕 (index 9) 和右手腕 (index 10) 的值
-            std::cout << "[PoseDetector] LeftWrist (idx 9): y=" << outputData[9*3+0]
-                      << " x=" << outputData[9*3+1] << " conf=" << outputData[9*3+2] << "\n";
-            std::cout << "[PoseDetector] RightWrist (idx 10): y=" << outputData[10*3+0]
-                      << " x=" << outputData[10*3+1] << " conf=" << outputData[10*3+2] << "\n";
-            debugCount++;
+        // 模型输出为归一化坐标，经信箱变换和裁剪区域换算到原始帧
+        MoveNetKeypoints keypoints;
+        decodeKeypoints(outputData, transform, crop, imageSize, frameWidth, frameHeight, keypoints);
+        if (tracker) {
+            tracker->update(keypoints, cv::Size(frameWidth, frameHeight));
         }
-
-        DetectedPerson person = parseOutput(outputData, frame.cols, frame.rows);
+        DetectedPerson person = parseOutput(keypoints);
 
         // 只有检测到有效关键点才添加
         if (person.leftHand.valid || person.rightHand.valid || person.shoulder.valid) {
@@ -301,8 +354,6 @@ std::vector<DetectedPerson> PoseDetector::detect(const cv::Mat& frame) {
 
     auto endTime = std::chrono::steady_clock::now();
     m_lastDetectionTime = std::chrono::duration<float, std::milli>(endTime - startTime).count();
-
-    return persons;
 #endif
 }
 
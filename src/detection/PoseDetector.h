@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -7,6 +9,9 @@
 
 namespace popcorn {
 
+struct LetterboxTransform;
+class PoseCropTracker;
+
 /**
  * 手部/关键点位置
  */
@@ -60,9 +65,20 @@ enum class MoveNetKeypoint {
     RightAnkle = 16
 };
 
+constexpr int MOVENET_KEYPOINT_COUNT = 17;
+
+/**
+ * 单人的全部 MoveNet 关键点（按 MoveNetKeypoint 索引）
+ */
+using MoveNetKeypoints = std::array<HandPosition, MOVENET_KEYPOINT_COUNT>;
+
 /**
  * 姿态检测器 (使用 ONNX Runtime + MoveNet)
  * 使用 PIMPL 模式隐藏 ONNX Runtime 依赖
+ *
+ * 输入输出名称在 initialize 中解析一次，输入输出张量预分配并经 IoBinding 绑定，
+ * 逐帧只把预处理结果写入绑定的输入缓冲；使用输出参数版本的 detect 时稳态推理不分配堆内存。
+ * 输入按保持宽高比的信箱方式缩放（LetterboxResizer），关键点再经同一变换映射回原始帧
  */
 class PoseDetector {
 public:
@@ -92,6 +108,25 @@ public:
      */
     std::vector<DetectedPerson> detect(const cv::Mat& frame);
 
+    /**
+     * 在采集线程生成的低分辨率检测图上检测，关键点按原始帧尺寸输出
+     * @param rgb 输入图像（RGB 格式，与原始帧宽高比相同）
+     * @param frameWidth 原始帧宽度
+     * @param frameHeight 原始帧高度
+     * @return 检测到的人物列表
+     */
+    std::vector<DetectedPerson> detectRGB(const cv::Mat& rgb, int frameWidth, int frameHeight);
+
+    /**
+     * 同上，结果写入 persons（复用其缓冲，避免每帧分配返回值）
+     * @param tracker 智能裁剪跟踪器（可为空）：按上一帧的关键点只检测人物周围的区域，
+     *                检测后用本帧关键点更新；每个视频流使用各自的实例
+     */
+    void detect(const cv::Mat& frame, std::vector<DetectedPerson>& persons,
+                PoseCropTracker* tracker = nullptr);
+    void detectRGB(const cv::Mat& rgb, int frameWidth, int frameHeight, std::vector<DetectedPerson>& persons,
+                   PoseCropTracker* tracker = nullptr);
+
     /**
      * 检测器是否已初始化
      */
@@ -102,17 +137,32 @@ public:
      */
     float getLastDetectionTime() const { return m_lastDetectionTime; }
 
+    /**
+     * 模型输入尺寸（采集端可据此生成检测用的小图）
+     */
+    int getInputWidth() const { return m_inputWidth; }
+    int getInputHeight() const { return m_inputHeight; }
+
     /**
      * 设置置信度阈值
      */
     void setConfidenceThreshold(float threshold) { m_confidenceThreshold = threshold; }
 
 private:
-    // 预处理图像
-    cv::Mat preprocessImage(const cv::Mat& frame);
+    // 检测实现
+    void detectImpl(const cv::Mat& frame, bool isRGB, int frameWidth, int frameHeight,
+                    std::vector<DetectedPerson>& persons, PoseCropTracker* tracker);
+
+    // 预分配输入输出张量并绑定（initialize 中调用）
+    bool bindTensors(const std::vector<int64_t>& outputShape);
+
+    // 解码输出：经信箱变换回到输入图中的裁剪区域，再按输入图到原始帧的比例换算
+    void decodeKeypoints(const float* output, const LetterboxTransform& transform, const cv::Rect& crop,
+                         const cv::Size& imageSize, int frameWidth, int frameHeight,
+                         MoveNetKeypoints& keypoints) const;
 
-    // 解析输出
-    DetectedPerson parseOutput(const float* output, int width, int height);
+    // 由关键点组装检测结果
+    DetectedPerson parseOutput(const MoveNetKeypoints& keypoints) const;
 
 private:
     // PIMPL - 隐藏 ONNX Runtime 实现细节
@@ -0,0 +1,134 @@
+#include "PoseWorker.h"
+#include "camera/CameraCapture.h"
+#include <chrono>
+#include <iostream>
+
+namespace popcorn {
+
+namespace {
+
+// 等待新帧的超时：期间没有帧也定期醒来检查停止标志
+constexpr int FRAME_WAIT_TIMEOUT_MS = 100;
+
+} // namespace
+
+PoseWorker::~PoseWorker() {
+    stop();
+}
+
+bool PoseWorker::start(PoseDetector& detector, CameraCapture& camera, Correction correction, bool smartCrop,
+                       const DetectionScheduler::Config& schedule) {
+    if (m_thread.joinable()) {
+        return true;
+    }
+    if (!detector.isInitialized()) {
+        std::cerr << "[PoseWorker] Pose detector not initialized\n";
+        return false;
+    }
+
+    m_detector = &detector;
+    m_camera = &camera;
+    m_correction = std::move(correction);
+    m_smartCrop = smartCrop;
+    m_cropTracker.reset();
+    m_scheduler.setConfig(schedule);
+    m_scheduler.reset();
+    m_running = true;
+    m_thread = std::thread(&PoseWorker::workerThread, this);
+    return true;
+}
+
+void PoseWorker::stop() {
+    m_running = false;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void PoseWorker::workerThread() {
+    std::cout << "[PoseWorker] Detection thread started\n";
+
+    uint64_t lastSequence = 0;
+    while (m_running) {
+        // 发布即唤醒；只借用最新帧，检测期间到达的中间帧被跳过
+        FrameHandle frame;
+        if (!m_camera->waitForFrame(frame, lastSequence, FRAME_WAIT_TIMEOUT_MS)) {
+            CaptureState state = m_camera->getState();
+            if (state == CaptureState::Finished || state == CaptureState::Stopped) {
+                break;
+            }
+            continue;
+        }
+
+        if (lastSequence != 0 && frame->sequence > lastSequence + 1) {
+            m_framesSkipped.fetch_add(frame->sequence - lastSequence - 1, std::memory_order_relaxed);
+        }
+        lastSequence = frame->sequence;
+
+        // 未到调度的检测时刻：直接归还帧，等下一帧
+        if (!m_scheduler.shouldDetect(frame->timestampUs)) {
+            m_framesThrottled.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        // 采集线程已生成检测图时直接使用；否则退回处理区域的 BGR。
+        // 智能裁剪跟踪中且帧本身是 BGR 时改用全分辨率视图：裁剪区域不再受检测图分辨率限制
+        PoseResult& result = m_results.writeBuffer();
+        PoseCropTracker* tracker = m_smartCrop ? &m_cropTracker : nullptr;
+        const cv::Rect region = frame->region();
+        const bool fullResolution = tracker && tracker->isTracking() && frame->format == PixelFormat::BGR;
+        if (!frame->detectionImage.empty() && !fullResolution) {
+            m_detector->detectRGB(frame->detectionImage, region.width, region.height, result.persons, tracker);
+        } else {
+            m_detector->detect(frameToBGR(*frame, m_bgrScratch), result.persons, tracker);
+        }
+        if (m_correction) {
+            m_correction(*frame, result.persons);
+        }
+
+        result.frameSequence = frame->sequence;
+        result.timestampUs = frame->timestampUs;
+        result.frameSize = cv::Size(frame->width(), frame->height());
+        result.detectionTimeMs = std::chrono::duration<float, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        result.fullResolution = frame->detectionImage.empty() || fullResolution;
+        m_scheduler.onDetection(frame->timestampUs, result.detectionTimeMs);
+        m_rateHz.store(m_scheduler.getRateHz(), std::memory_order_relaxed);
+
+        // 先归还帧槽位再发布，结果里不保留帧的引用
+        frame.reset();
+        m_results.publish();
+        m_framesDetected.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::cout << "[PoseWorker] Detection thread ended\n";
+}
+
+bool PoseWorker::poll(PoseResult& result) {
+    // 中间缓冲换到前台；换出的旧前台缓冲交给检测线程复用
+    if (!m_results.update()) {
+        return false;
+    }
+
+    const PoseResult& latest = m_results.readBuffer();
+    result.persons.assign(latest.persons.begin(), latest.persons.end());
+    result.frameSequence = latest.frameSequence;
+    result.timestampUs = latest.timestampUs;
+    result.frameSize = latest.frameSize;
+    result.detectionTimeMs = latest.detectionTimeMs;
+    result.fullResolution = latest.fullResolution;
+    return true;
+}
+
+PoseWorker::Stats PoseWorker::getStats() const {
+    Stats stats;
+    stats.framesDetected = m_framesDetected.load(std::memory_order_relaxed);
+    stats.framesSkipped = m_framesSkipped.load(std::memory_order_relaxed);
+    stats.framesThrottled = m_framesThrottled.load(std::memory_order_relaxed);
+    stats.rateHz = m_rateHz.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace popcorn
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "DetectionScheduler.h"
+#include "PoseCropTracker.h"
+#include "PoseDetector.h"
+#include "camera/CameraFrame.h"
+#include "core/TripleBuffer.h"
+
+namespace popcorn {
+
+class CameraCapture;
+
+/**
+ * 一次姿态检测的结果
+ * 携带源帧的序号和采集时间戳，使用方据此判断结果的新旧和延迟
+ */
+struct PoseResult {
+    std::vector<DetectedPerson> persons;    // 整帧像素坐标（已经过校正回调）
+    uint64_t frameSequence{0};              // 源帧序号；0 表示还没有结果
+    int64_t timestampUs{0};                 // 源帧采集时间戳（steady_clock，微秒）
+    cv::Size frameSize;                     // 源帧尺寸
+    float detectionTimeMs{0.0f};            // 推理耗时（含预处理与校正）
+    bool fullResolution{false};             // 在全分辨率帧上检测（耗时随采集分辨率变化）
+};
+
+/**
+ * 异步姿态检测
+ *
+ * 在独立线程中阻塞等待摄像头的新帧（CameraCapture::waitForFrame），总是取最新帧检测：
+ * 推理期间到达的帧只保留最后一帧，过时的帧直接跳过。
+ * 结果经三缓冲（TripleBuffer）发布：检测线程写后台槽位后与中间槽位原子交换，
+ * 主线程 poll 时若有新结果再与前台槽位交换，双方都不加锁、不等待。
+ *
+ * 启动后 PoseDetector 只由检测线程使用；stop 之前不得在其他线程调用它
+ */
+class PoseWorker {
+public:
+    /**
+     * 关键点校正回调（在检测线程中调用）：把检测结果从处理区域坐标映射回整帧坐标、去畸变等
+     * 回调持有的状态只由检测线程访问
+     */
+    using Correction = std::function<void(const CameraFrame& frame, std::vector<DetectedPerson>& persons)>;
+
+    /**
+     * 统计
+     */
+    struct Stats {
+        uint64_t framesDetected{0};     // 已检测的帧数
+        uint64_t framesSkipped{0};      // 检测期间到达、被更新的帧取代而未检测的帧数
+        uint64_t framesThrottled{0};    // 检测频率调度跳过的帧数
+        float rateHz{0.0f};             // 当前检测频率上限（0 表示每帧都检测）
+    };
+
+    PoseWorker() = default;
+    ~PoseWorker();
+
+    // 禁止拷贝
+    PoseWorker(const PoseWorker&) = delete;
+    PoseWorker& operator=(const PoseWorker&) = delete;
+
+    /**
+     * 启动检测线程
+     * @param detector 已初始化的姿态检测器（stop 之前须保持有效）
+     * @param camera 帧来源（stop 之前须保持有效）
+     * @param correction 关键点校正回调（可为空）
+     * @param smartCrop 是否按上一帧的关键点只检测人物周围的区域（PoseCropTracker）
+     * @param schedule 检测频率调度参数（cpuBudget 为 1 时每帧都检测）
+     * @return 成功返回 true
+     */
+    bool start(PoseDetector& detector, CameraCapture& camera, Correction correction, bool smartCrop,
+               const DetectionScheduler::Config& schedule);
+
+    /**
+     * 停止并等待检测线程退出（最多等待一次推理）
+     */
+    void stop();
+
+    /**
+     * 检测线程是否在运行
+     */
+    bool isRunning() const { return m_thread.joinable(); }
+
+    /**
+     * 取最新结果（不阻塞、无锁；只能由一个线程调用）
+     * @param result 输出：有新结果时复制到这里（复用其缓冲）
+     * @return 自上次 poll 以来有新结果返回 true
+     */
+    bool poll(PoseResult& result);
+
+    /**
+     * 获取统计（任意线程）
+     */
+    Stats getStats() const;
+
+private:
+    // 检测线程函数
+    void workerThread();
+
+private:
+    // 结果邮箱：检测线程写后台缓冲，poll 的调用线程读前台缓冲
+    TripleBuffer<PoseResult> m_results;
+
+    PoseDetector* m_detector{nullptr};
+    CameraCapture* m_camera{nullptr};
+    Correction m_correction;
+    bool m_smartCrop{false};
+    PoseCropTracker m_cropTracker;  // 仅检测线程访问
+    DetectionScheduler m_scheduler; // 仅检测线程访问
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_framesDetected{0};
+    std::atomic<uint64_t> m_framesSkipped{0};
+    std::atomic<uint64_t> m_framesThrottled{0};
+    std::atomic<float> m_rateHz{0.0f};
+
+    cv::Mat m_bgrScratch;   // 没有检测图时 YUV 帧转 BGR 的缓冲（仅检测线程访问）
+};
+
+} // namespace popcorn
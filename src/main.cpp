@@ -5,9 +5,240 @@
  * 技术栈：SDL2 + OpenGL + OpenCV + MediaPipe
  */
 
+#include <cstdio>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
 #include "core/Application.h"
+#include "detection/OrtRuntime.h"
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --camera <id>        使用指定摄像头（默认 0）\n"
+              << "  --video <file>       回放录制的视频文件\n"
+              << "  --images <dir>       回放 PNG/JPEG 图片序列\n"
+              << "  --v4l2 <device>      Linux V4L2 原生采集（如 /dev/video0）\n"
+              << "  --session <file>     逐帧重放 --record 录制的会话\n"
+              << "  --synthetic <scene>  合成玩家帧源，场景为逗号分隔的 figure / blob（如 figure,blob）\n"
+              << "  --gst <pipeline>     GStreamer 管线采集（不含 sink，如 \"videotestsrc is-live=true\"）\n"
+              << "  --format <fmt>       V4L2 像素格式: auto | yuyv | mjpeg | nv12（默认 auto）\n"
+              << "  --yuv                V4L2 / GStreamer 的 YUV 帧不转 BGR，在 GPU 上转换颜色\n"
+              << "  --pacing <mode>      回放节奏: realtime | fast | fixed（默认 realtime）\n"
+              << "  --size <WxH>         摄像头 / 合成帧源的分辨率（默认 1280x720）\n"
+              << "  --fps <n>            摄像头帧率 / fixed 与图片序列的播放帧率\n"
+              << "  --no-loop            文件播放结束后退出而不是循环\n"
+              << "  --record <file>      录制采集到的每一帧（数据文件 + .idx 索引，多摄像头追加 .cam<序号>）\n"
+              << "  --record-jpeg        录制时压缩为 JPEG（默认保存原始像素）\n"
+              << "  --no-adapt           不按负载自动调节采集分辨率和帧率\n"
+              << "  --sync-pose          在主线程中同步运行姿态检测（默认在独立线程中运行）\n"
+              << "  --no-smart-crop      每帧都检测整个画面，不按上一帧的人物位置裁剪\n"
+              << "  --no-pose-filter     直接使用原始关键点，不做 One Euro 滤波和延迟补偿外推\n"
+              << "  --pose-budget <f>    姿态推理可占用的 CPU 时间比例（0-1，默认 0.5；1 为每帧都检测）\n"
+              << "  --ort-threads <n[,m]> 所有检测器共用的 ONNX Runtime 线程池：intra-op n 个、inter-op m 个（默认 2,1）\n"
+              << "  --ort-spin           ONNX Runtime 线程池空闲时自旋等待（唤醒略快，但占满核心）\n"
+              << "  --calibration <file> 镜头标定文件（OpenCV 格式），用于关键点去畸变；出现在帧源参数之后时只作用于最近的帧源\n"
+              << "  --crop <x,y,w,h>      只处理画面的该区域（相对整帧的归一化坐标，如 0,0.2,1,0.6）；位置规则同 --calibration\n"
+              << "  --homography <file>  多摄像头到屏幕坐标的单应矩阵（camera0、camera1... 3x3）\n"
+              << "帧源参数（--camera/--video/--images/--v4l2/--gst/--session/--synthetic）可重复给出，每个对应一个摄像头，\n"
+              << "多个帧源时同步采集并把检测结果映射到同一屏幕空间；其余参数对所有帧源生效\n";
+}
+
+/**
+ * 解析命令行中的帧源参数
+ * 每个帧源参数新增一个摄像头，其余参数作用于所有帧源；未指定帧源时为 0 号摄像头
+ * @return 参数有误返回 false
+ */
+bool parseSourceArgs(int argc, char* argv[], std::vector<popcorn::FrameSourceConfig>& sources,
+                     std::string& homographyPath, bool& adaptiveCapture, bool& asyncPose,
+                     bool& smartCrop, bool& poseFiltering, float& poseBudget,
+                     popcorn::OrtRuntimeConfig& ortConfig, std::string& recordPath, bool& recordJpeg) {
+    using popcorn::CaptureFormat;
+    using popcorn::FrameSourceType;
+    using popcorn::PacingMode;
+
+    popcorn::FrameSourceConfig config;
+    std::vector<popcorn::FrameSourceConfig> selected;   // 仅类型、设备号、路径、标定文件、处理区域有效
+    const cv::Rect2f fullFrame(0.0f, 0.0f, 1.0f, 1.0f);
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&](std::string& value) {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                return false;
+            }
+            value = argv[++i];
+            return true;
+        };
+
+        std::string value;
+        if (arg == "--camera") {
+            if (!next(value)) return false;
+            selected.emplace_back();
+            selected.back().type = FrameSourceType::Camera;
+            char extra = 0;
+            if (std::sscanf(value.c_str(), "%d%c", &selected.back().deviceId, &extra) != 1 ||
+                selected.back().deviceId < 0) {
+                std::cerr << "Invalid camera index: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--video") {
+            if (!next(value)) return false;
+            selected.emplace_back();
+            selected.back().type = FrameSourceType::VideoFile;
+            selected.back().path = value;
+        } else if (arg == "--images") {
+            if (!next(value)) return false;
+            selected.emplace_back();
+            selected.back().type = FrameSourceType::ImageSequence;
+            selected.back().path = value;
+        } else if (arg == "--v4l2") {
+            if (!next(value)) return false;
+            selected.emplace_back();
+            selected.back().type = FrameSourceType::V4L2;
+            selected.back().path = value;
+        } else if (arg == "--gst") {
+            if (!next(value)) return false;
+            selected.emplace_back();
+            selected.back().type = FrameSourceType::GStreamer;
+            selected.back().path = value;
+        } else if (arg == "--session") {
+            if (!next(value)) return false;
+            selected.emplace_back();
+            selected.back().type = FrameSourceType::Session;
+            selected.back().path = value;
+        } else if (arg == "--synthetic") {
+            if (!next(value)) return false;
+            selected.emplace_back();
+            selected.back().type = FrameSourceType::Synthetic;
+            selected.back().path = value;
+        } else if (arg == "--format") {
+            if (!next(value)) return false;
+            if (value == "auto") {
+                config.format = CaptureFormat::Auto;
+            } else if (value == "yuyv") {
+                config.format = CaptureFormat::YUYV;
+            } else if (value == "mjpeg") {
+                config.format = CaptureFormat::MJPEG;
+            } else if (value == "nv12") {
+                config.format = CaptureFormat::NV12;
+            } else {
+                std::cerr << "Unknown capture format: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--yuv") {
+            config.keepYuv = true;
+        } else if (arg == "--pacing") {
+            if (!next(value)) return false;
+            if (value == "realtime") {
+                config.pacing = PacingMode::RealTime;
+            } else if (value == "fast") {
+                config.pacing = PacingMode::AsFastAsPossible;
+            } else if (value == "fixed") {
+                config.pacing = PacingMode::FixedRate;
+            } else {
+                std::cerr << "Unknown pacing mode: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--size") {
+            if (!next(value)) return false;
+            char extra = 0;
+            if (std::sscanf(value.c_str(), "%dx%d%c", &config.width, &config.height, &extra) != 2 ||
+                config.width <= 0 || config.height <= 0) {
+                std::cerr << "Invalid size (expected WxH): " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--fps") {
+            if (!next(value)) return false;
+            char extra = 0;
+            if (std::sscanf(value.c_str(), "%lf%c", &config.fps, &extra) != 1 || !(config.fps > 0.0)) {
+                std::cerr << "Invalid frame rate: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--no-loop") {
+            config.loop = false;
+        } else if (arg == "--record") {
+            if (!next(recordPath)) return false;
+        } else if (arg == "--record-jpeg") {
+            recordJpeg = true;
+        } else if (arg == "--no-adapt") {
+            adaptiveCapture = false;
+        } else if (arg == "--sync-pose") {
+            asyncPose = false;
+        } else if (arg == "--no-smart-crop") {
+            smartCrop = false;
+        } else if (arg == "--no-pose-filter") {
+            poseFiltering = false;
+        } else if (arg == "--pose-budget") {
+            if (!next(value)) return false;
+            char extra = 0;
+            if (std::sscanf(value.c_str(), "%f%c", &poseBudget, &extra) != 1 ||
+                !(poseBudget > 0.0f && poseBudget <= 1.0f)) {
+                std::cerr << "Invalid pose budget (expected 0-1): " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--ort-threads") {
+            if (!next(value)) return false;
+            int fields = std::sscanf(value.c_str(), "%d,%d", &ortConfig.intraOpThreads, &ortConfig.interOpThreads);
+            if (fields < 1 || ortConfig.intraOpThreads < 1 || ortConfig.interOpThreads < 1) {
+                std::cerr << "Invalid ONNX Runtime threads (expected n or n,m): " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--ort-spin") {
+            ortConfig.allowSpinning = true;
+        } else if (arg == "--calibration") {
+            if (!next(value)) return false;
+            if (selected.empty()) {
+                config.calibrationPath = value;
+            } else {
+                selected.back().calibrationPath = value;
+            }
+        } else if (arg == "--crop") {
+            if (!next(value)) return false;
+            cv::Rect2f crop;
+            if (std::sscanf(value.c_str(), "%f,%f,%f,%f", &crop.x, &crop.y, &crop.width, &crop.height) != 4 ||
+                crop.x < 0.0f || crop.y < 0.0f || crop.width <= 0.0f || crop.height <= 0.0f ||
+                crop.x + crop.width > 1.001f || crop.y + crop.height > 1.001f) {
+                std::cerr << "Invalid crop (expected normalized x,y,w,h): " << value << "\n";
+                return false;
+            }
+            if (selected.empty()) {
+                config.crop = crop;
+            } else {
+                selected.back().crop = crop;
+            }
+        } else if (arg == "--homography") {
+            if (!next(homographyPath)) return false;
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return false;
+        }
+    }
+
+    if (selected.empty()) {
+        selected.emplace_back();
+    }
+    sources.clear();
+    for (const auto& source : selected) {
+        popcorn::FrameSourceConfig merged = config;
+        merged.type = source.type;
+        merged.deviceId = source.deviceId;
+        merged.path = source.path;
+        if (!source.calibrationPath.empty()) {
+            merged.calibrationPath = source.calibrationPath;
+        }
+        if (source.crop != fullFrame) {
+            merged.crop = source.crop;
+        }
+        sources.push_back(merged);
+    }
+    return true;
+}
+
+} // namespace
 
 int main(int argc, char* argv[]) {
     std::cout << "========================================\n";
@@ -15,11 +246,43 @@ int main(int argc, char* argv[]) {
     std::cout << "========================================\n";
 
     try {
+        // 解析帧源参数（默认 0 号摄像头）
+        std::vector<popcorn::FrameSourceConfig> sources;
+        std::string homographyPath;
+        bool adaptiveCapture = true;
+        bool asyncPose = true;
+        bool smartCrop = true;
+        bool poseFiltering = true;
+        float poseBudget = 0.5f;
+        popcorn::OrtRuntimeConfig ortConfig;
+        std::string recordPath;
+        bool recordJpeg = false;
+        if (!parseSourceArgs(argc, argv, sources, homographyPath, adaptiveCapture, asyncPose,
+                             smartCrop, poseFiltering, poseBudget, ortConfig, recordPath, recordJpeg)) {
+            printUsage(argv[0]);
+            return -1;
+        }
+
+        // 所有检测器共用的推理线程池（须在创建检测器之前配置）
+        popcorn::OrtRuntime::configure(ortConfig);
+
         // 创建应用实例
         auto app = std::make_unique<popcorn::Application>();
+        app->setAdaptiveCapture(adaptiveCapture);
+        app->setAsyncPose(asyncPose);
+        app->setPoseSmartCrop(smartCrop);
+        app->setPoseFiltering(poseFiltering);
+        app->setPoseBudget(poseBudget);
+        if (!recordPath.empty()) {
+            popcorn::SessionRecorder::Options recordOptions;
+            if (recordJpeg) {
+                recordOptions.encoding = popcorn::SessionEncoding::Jpeg;
+            }
+            app->setRecording(recordPath, recordOptions);
+        }
 
         // 初始化
-        if (!app->initialize(1920, 1080, "爆米花大作战")) {
+        if (!app->initialize(1920, 1080, "爆米花大作战", sources, homographyPath)) {
             std::cerr << "Failed to initialize application\n";
             return -1;
         }
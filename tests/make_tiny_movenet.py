@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+生成 tests/models/tiny_movenet.onnx：与 MoveNet Lightning 输入输出相同的极小模型
+
+输入 int32 [1, 192, 192, 3]，输出 float [1, 1, 17, 3]：取输入中心一行的 17 个像素除以 255，
+作为 (y, x, 置信度)：中心落在信箱的内容区域内，关键点随画面变化，智能裁剪也会启动。
+推理几乎不花时间，但 PoseDetector 的预处理、绑定和解码路径与真实模型完全相同，
+供 pose_detector_alloc 测试在没有真实模型的 CI 上运行。
+
+只用标准库手写 protobuf，不依赖 onnx 包：
+    python3 tests/make_tiny_movenet.py tests/models/tiny_movenet.onnx
+"""
+
+import struct
+import sys
+
+INPUT_SIZE = 192
+KEYPOINTS = 17
+CENTER = INPUT_SIZE // 2
+
+FLOAT = 1
+INT32 = 6
+INT64 = 7
+ATTRIBUTE_INT = 2
+
+
+def varint(value):
+    out = bytearray()
+    value &= (1 << 64) - 1
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def field_varint(number, value):
+    return varint(number << 3) + varint(value)
+
+
+def field_bytes(number, payload):
+    if isinstance(payload, str):
+        payload = payload.encode()
+    return varint((number << 3) | 2) + varint(len(payload)) + payload
+
+
+def tensor(name, data_type, dims, raw):
+    out = b"".join(field_varint(1, d) for d in dims)
+    out += field_varint(2, data_type)
+    out += field_bytes(8, name)
+    out += field_bytes(9, raw)
+    return out
+
+
+def int64_tensor(name, values):
+    return tensor(name, INT64, [len(values)], struct.pack("<%dq" % len(values), *values))
+
+
+def value_info(name, elem_type, dims):
+    shape = b"".join(field_bytes(1, field_varint(1, d)) for d in dims)
+    tensor_type = field_varint(1, elem_type) + field_bytes(2, shape)
+    return field_bytes(1, name) + field_bytes(2, field_bytes(1, tensor_type))
+
+
+def node(op_type, inputs, outputs, name, attributes=b""):
+    out = b"".join(field_bytes(1, i) for i in inputs)
+    out += b"".join(field_bytes(2, o) for o in outputs)
+    out += field_bytes(3, name)
+    out += field_bytes(4, op_type)
+    out += attributes
+    return out
+
+
+def int_attribute(name, value):
+    return field_bytes(5, field_bytes(1, name) + field_varint(3, value) + field_varint(20, ATTRIBUTE_INT))
+
+
+def build_model():
+    nodes = [
+        node("Cast", ["input"], ["as_float"], "cast", int_attribute("to", FLOAT)),
+        node("Slice", ["as_float", "starts", "ends"], ["center"], "slice"),
+        node("Mul", ["center", "scale"], ["output_0"], "normalize"),
+    ]
+    initializers = [
+        int64_tensor("starts", [0, CENTER, CENTER - KEYPOINTS // 2, 0]),
+        int64_tensor("ends", [1, CENTER + 1, CENTER - KEYPOINTS // 2 + KEYPOINTS, 3]),
+        tensor("scale", FLOAT, [], struct.pack("<f", 1.0 / 255.0)),
+    ]
+
+    graph = b"".join(field_bytes(1, n) for n in nodes)
+    graph += field_bytes(2, "tiny_movenet")
+    graph += b"".join(field_bytes(5, t) for t in initializers)
+    graph += field_bytes(11, value_info("input", INT32, [1, INPUT_SIZE, INPUT_SIZE, 3]))
+    graph += field_bytes(12, value_info("output_0", FLOAT, [1, 1, KEYPOINTS, 3]))
+
+    model = field_varint(1, 7)                                  # ir_version
+    model += field_bytes(2, "popcorn-tests")                    # producer_name
+    model += field_bytes(7, graph)
+    model += field_bytes(8, field_bytes(1, "") + field_varint(2, 13))  # opset_import: ai.onnx 13
+    return model
+
+
+def main():
+    path = sys.argv[1] if len(sys.argv) > 1 else "tiny_movenet.onnx"
+    with open(path, "wb") as f:
+        f.write(build_model())
+
+
+if __name__ == "__main__":
+    main()
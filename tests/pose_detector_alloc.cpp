@@ -0,0 +1,126 @@
+/**
+ * PoseDetector 稳态零分配测试
+ *
+ * 替换全局 operator new 计数堆分配：预热几帧之后，输出参数版本的 detect
+ * 重复调用 N 次，本项目代码（预处理、绑定、解码、智能裁剪）的分配次数应为零。
+ * Session::Run 内部每次都会构造 feed / fetch 管理器等对象，不在本项目控制之内：
+ * 经 OrtRuntime::setRunObserver 在推理期间暂停计数（ORT 的线程池线程只在推理期间工作），
+ * 推理内部的分配次数单独打印，仅供参考。
+ * 分别覆盖整帧检测和智能裁剪（PoseCropTracker）两条路径。
+ *
+ * 用法：pose_detector_alloc [模型路径]
+ * 默认使用 tests/models/tiny_movenet.onnx（输入输出与 MoveNet Lightning 相同的极小模型，
+ * 由 tests/make_tiny_movenet.py 生成）；模型文件不存在时跳过（返回 77）
+ */
+
+#include "detection/OrtRuntime.h"
+#include "detection/PoseCropTracker.h"
+#include "detection/PoseDetector.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};         // 本项目代码的分配
+std::atomic<uint64_t> g_runAllocations{0};      // 推理期间（ORT 内部）的分配
+std::atomic<bool> g_inRun{false};
+
+constexpr int SKIP_RETURN_CODE = 77;
+constexpr int WARMUP_DETECTIONS = 5;
+constexpr int MEASURED_DETECTIONS = 100;
+
+void countAllocation() {
+    if (g_inRun.load(std::memory_order_relaxed)) {
+        g_runAllocations.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void onRun(bool running) {
+    g_inRun.store(running, std::memory_order_relaxed);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    countAllocation();
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    countAllocation();
+    return std::malloc(size ? size : 1);
+}
+
+// 数组形式的 new / delete 默认转发到这里的单对象版本
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+/**
+ * 预热后重复检测，返回稳态下本项目代码的分配次数
+ */
+uint64_t countSteadyStateAllocations(const char* name, popcorn::PoseDetector& detector, const cv::Mat& frame,
+                                     popcorn::PoseCropTracker* tracker) {
+    std::vector<popcorn::DetectedPerson> persons;
+    persons.reserve(4);
+    for (int i = 0; i < WARMUP_DETECTIONS; ++i) {
+        detector.detect(frame, persons, tracker);
+    }
+
+    uint64_t before = g_allocations.load(std::memory_order_relaxed);
+    uint64_t runBefore = g_runAllocations.load(std::memory_order_relaxed);
+    size_t detected = 0;
+    for (int i = 0; i < MEASURED_DETECTIONS; ++i) {
+        detector.detect(frame, persons, tracker);
+        detected += persons.size();
+    }
+    uint64_t allocations = g_allocations.load(std::memory_order_relaxed) - before;
+    uint64_t runAllocations = g_runAllocations.load(std::memory_order_relaxed) - runBefore;
+
+    std::printf("[AllocTest] %s: %llu allocations in %d detections (%zu persons; inside Session::Run: %llu)\n",
+                name, static_cast<unsigned long long>(allocations), MEASURED_DETECTIONS, detected,
+                static_cast<unsigned long long>(runAllocations));
+    return allocations;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string modelPath = argc > 1 ? argv[1] : "tests/models/tiny_movenet.onnx";
+    if (!std::ifstream(modelPath).good()) {
+        std::printf("[AllocTest] Model not found: %s, skipped\n", modelPath.c_str());
+        return SKIP_RETURN_CODE;
+    }
+
+    popcorn::PoseDetector detector;
+    if (!detector.initialize(modelPath)) {
+        std::printf("[AllocTest] Failed to initialize detector\n");
+        return 1;
+    }
+    popcorn::OrtRuntime::setRunObserver(onRun);
+
+    // 固定的随机画面：检测结果本身不重要，只需走完整条推理路径
+    cv::Mat frame(720, 1280, CV_8UC3);
+    cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+
+    int failures = 0;
+    failures += countSteadyStateAllocations("Full frame", detector, frame, nullptr) != 0;
+
+    popcorn::PoseCropTracker tracker;
+    failures += countSteadyStateAllocations("Smart crop", detector, frame, &tracker) != 0;
+
+    popcorn::OrtRuntime::setRunObserver(nullptr);
+    std::printf("[AllocTest] %s\n", failures == 0 ? "PASSED" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}